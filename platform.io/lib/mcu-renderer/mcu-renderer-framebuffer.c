@@ -0,0 +1,193 @@
+/*
+ * MCU renderer
+ * Offscreen framebuffer driver
+ *
+ * (C) 2023-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(MCURENDERER_FRAMEBUFFER)
+
+#include <stdlib.h>
+
+#include "mcu-renderer-framebuffer.h"
+
+// ST7789: CASET, RASET (4 bytes each) and RAMWR
+#define MR_FRAMEBUFFER_COLOR_WINDOW_SIZE (1 + 4 + 1 + 4 + 1)
+// ST7565: page address, column address LSB and MSB
+#define MR_FRAMEBUFFER_MONOCHROME_PAGE_SIZE 3
+
+typedef struct
+{
+    enum mr_framebuffer_display_type_t display_type;
+
+    mr_framebuffer_stats_t stats;
+
+    mr_draw_rectangle_callback_t draw_rectangle_callback;
+    mr_draw_string_callback_t draw_string_callback;
+#if defined(MCURENDERER_BITMAP_SUPPORT)
+    mr_draw_bitmap_callback_t draw_bitmap_callback;
+#endif
+#if defined(MCURENDERER_IMAGE_SUPPORT)
+    mr_draw_image_callback_t draw_image_callback;
+#endif
+} mr_framebuffer_display_t;
+
+static void mr_framebuffer_add_draw(mr_t *mr,
+                                    const mr_rectangle_t *rectangle)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    uint32_t pixel_count = rectangle->width * rectangle->height;
+
+    display->stats.draw_count++;
+    display->stats.pixel_count += pixel_count;
+
+    // Color displays are sent each draw call
+    if (display->display_type == MR_FRAMEBUFFER_DISPLAY_TYPE_COLOR)
+        display->stats.sent_bytes += MR_FRAMEBUFFER_COLOR_WINDOW_SIZE +
+                                     sizeof(mr_color_t) * pixel_count;
+}
+
+static void mr_framebuffer_draw_rectangle(mr_t *mr,
+                                          const mr_rectangle_t *rectangle)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    mr_framebuffer_add_draw(mr, rectangle);
+
+    display->draw_rectangle_callback(mr, rectangle);
+}
+
+static void mr_framebuffer_draw_string(mr_t *mr,
+                                       const uint8_t *str,
+                                       const mr_rectangle_t *rectangle,
+                                       const mr_point_t *offset,
+                                       mr_get_charcode_callback_t get_charcode_callback)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    mr_framebuffer_add_draw(mr, rectangle);
+
+    display->draw_string_callback(mr,
+                                  str,
+                                  rectangle,
+                                  offset,
+                                  get_charcode_callback);
+}
+
+#if defined(MCURENDERER_BITMAP_SUPPORT)
+static void mr_framebuffer_draw_bitmap(mr_t *mr,
+                                       const mr_rectangle_t *rectangle,
+                                       const uint8_t *bitmap)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    mr_framebuffer_add_draw(mr, rectangle);
+
+    display->draw_bitmap_callback(mr, rectangle, bitmap);
+}
+#endif
+
+#if defined(MCURENDERER_IMAGE_SUPPORT)
+static void mr_framebuffer_draw_image(mr_t *mr,
+                                      const mr_rectangle_t *rectangle,
+                                      const mr_color_t *image)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    mr_framebuffer_add_draw(mr, rectangle);
+
+    display->draw_image_callback(mr, rectangle, image);
+}
+#endif
+
+void mr_framebuffer_init(mr_t *mr,
+                         uint32_t width,
+                         uint32_t height,
+                         enum mr_framebuffer_display_type_t display_type)
+{
+    mr_init(mr);
+
+    mr_framebuffer_display_t *display = calloc(sizeof(mr_framebuffer_display_t), 1);
+    mr->display = display;
+
+    mr->display_width = width;
+    mr->display_height = height;
+
+    display->display_type = display_type;
+
+    if (display_type == MR_FRAMEBUFFER_DISPLAY_TYPE_COLOR)
+    {
+        display->draw_rectangle_callback = mr_draw_rectangle_framebuffer_color;
+        display->draw_string_callback = mr_draw_string_framebuffer_color;
+#if defined(MCURENDERER_BITMAP_SUPPORT)
+        display->draw_bitmap_callback = mr_draw_bitmap_framebuffer_color;
+#endif
+#if defined(MCURENDERER_IMAGE_SUPPORT)
+        display->draw_image_callback = mr_draw_image_framebuffer_color;
+#endif
+
+        mr->buffer_size = sizeof(mr_color_t) * width * height;
+    }
+    else
+    {
+        display->draw_rectangle_callback = mr_draw_rectangle_framebuffer_monochrome_vertical;
+        display->draw_string_callback = mr_draw_string_framebuffer_monochrome_vertical;
+#if defined(MCURENDERER_BITMAP_SUPPORT)
+        display->draw_bitmap_callback = mr_draw_bitmap_framebuffer_monochrome_vertical;
+#endif
+#if defined(MCURENDERER_IMAGE_SUPPORT)
+        display->draw_image_callback = mr_draw_image_framebuffer_monochrome_vertical;
+#endif
+
+        mr->buffer_size = width * ((height + 7) / 8);
+    }
+
+    mr->buffer = calloc(mr->buffer_size, 1);
+
+    mr->draw_rectangle_callback = mr_framebuffer_draw_rectangle;
+    mr->draw_string_callback = mr_framebuffer_draw_string;
+#if defined(MCURENDERER_BITMAP_SUPPORT)
+    mr->draw_bitmap_callback = mr_framebuffer_draw_bitmap;
+#endif
+#if defined(MCURENDERER_IMAGE_SUPPORT)
+    mr->draw_image_callback = mr_framebuffer_draw_image;
+#endif
+}
+
+void mr_framebuffer_free(mr_t *mr)
+{
+    free(mr->display);
+    free(mr->buffer);
+
+    mr->display = NULL;
+    mr->buffer = NULL;
+}
+
+void mr_framebuffer_refresh_display(mr_t *mr)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    // Monochrome displays are sent page by page on refresh
+    if (display->display_type == MR_FRAMEBUFFER_DISPLAY_TYPE_MONOCHROME)
+        display->stats.sent_bytes += ((mr->display_height + 7) / 8) *
+                                     (MR_FRAMEBUFFER_MONOCHROME_PAGE_SIZE + mr->display_width);
+}
+
+const mr_framebuffer_stats_t *mr_framebuffer_get_stats(mr_t *mr)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    return &display->stats;
+}
+
+void mr_framebuffer_reset_stats(mr_t *mr)
+{
+    mr_framebuffer_display_t *display = (mr_framebuffer_display_t *)mr->display;
+
+    display->stats = (mr_framebuffer_stats_t){0};
+}
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * MCU renderer
+ * Offscreen framebuffer driver
+ *
+ * (C) 2023-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if !defined(MCURENDERER_FRAMEBUFFER_H)
+#define MCURENDERER_FRAMEBUFFER_H
+
+#include "mcu-renderer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum mr_framebuffer_display_type_t
+{
+    MR_FRAMEBUFFER_DISPLAY_TYPE_COLOR,
+    MR_FRAMEBUFFER_DISPLAY_TYPE_MONOCHROME,
+};
+
+typedef struct
+{
+    uint64_t draw_count;
+    uint64_t pixel_count;
+    uint64_t sent_bytes;
+} mr_framebuffer_stats_t;
+
+/**
+ * Initializes an mcu-renderer offscreen framebuffer instance. Color
+ * framebuffers are RGB565, monochrome framebuffers are vertical-byte as on
+ * the ST7565. Draw calls are accounted as the ST7789 (color) or ST7565
+ * (monochrome) drivers would send them.
+ *
+ * @param mr The mcu-renderer instance.
+ * @param width The desired display width.
+ * @param height The desired display height.
+ * @param display_type The desired display type.
+ */
+void mr_framebuffer_init(mr_t *mr,
+                         uint32_t width,
+                         uint32_t height,
+                         enum mr_framebuffer_display_type_t display_type);
+
+/**
+ * Frees an mcu-renderer offscreen framebuffer instance.
+ *
+ * @param mr The mcu-renderer instance.
+ */
+void mr_framebuffer_free(mr_t *mr);
+
+/**
+ * Refreshes the offscreen framebuffer display.
+ *
+ * @param mr The mcu-renderer instance.
+ */
+void mr_framebuffer_refresh_display(mr_t *mr);
+
+/**
+ * Returns the draw statistics since the last reset.
+ *
+ * @param mr The mcu-renderer instance.
+ * @return The draw statistics.
+ */
+const mr_framebuffer_stats_t *mr_framebuffer_get_stats(mr_t *mr);
+
+/**
+ * Resets the draw statistics.
+ *
+ * @param mr The mcu-renderer instance.
+ */
+void mr_framebuffer_reset_stats(mr_t *mr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -7,6 +7,8 @@
  * License: MIT
  */
 
+#include <string.h>
+
 #include "mcu-renderer-st7565.h"
 
 static const uint8_t mr_st7565_init_sequence[] = {
@@ -71,6 +73,19 @@ void mr_st7565_init(mr_t *mr,
     mr_send_sequence(mr, mr_st7565_init_sequence);
 }
 
+void mr_st7565_set_shadow_framebuffer(mr_t *mr,
+                                      uint8_t *shadow_framebuffer)
+{
+    mr->shadow_buffer = shadow_framebuffer;
+
+    // Forces a full first refresh
+    uint8_t *buffer = (uint8_t *)mr->buffer;
+    uint32_t buffer_size = mr->display_width * mr->display_height / 8;
+
+    for (uint32_t i = 0; i < buffer_size; i++)
+        shadow_framebuffer[i] = ~buffer[i];
+}
+
 void mr_st7565_set_display(mr_t *mr,
                            bool value)
 {
@@ -88,22 +103,48 @@ void mr_st7565_refresh_display(mr_t *mr)
          pageIndex < (mr->display_height / 8);
          pageIndex++)
     {
+        uint8_t *buffer = (uint8_t *)mr->buffer +
+                          mr->display_width * pageIndex;
+
+        int16_t start_column = 0;
+        int16_t end_column = mr->display_width;
+
+        if (mr->shadow_buffer)
+        {
+            // Send changed columns only
+            uint8_t *shadow_buffer = (uint8_t *)mr->shadow_buffer +
+                                     mr->display_width * pageIndex;
+
+            while ((start_column < end_column) &&
+                   (buffer[start_column] == shadow_buffer[start_column]))
+                start_column++;
+
+            while ((end_column > start_column) &&
+                   (buffer[end_column - 1] == shadow_buffer[end_column - 1]))
+                end_column--;
+
+            if (start_column == end_column)
+                continue;
+
+            memcpy(shadow_buffer + start_column,
+                   buffer + start_column,
+                   end_column - start_column);
+        }
+
         // Send page address
         mr_send_command(mr, MR_ST7565_PAGE_ADDRESS | pageIndex);
 
         // Send column address
-        mr_send_command(mr, MR_ST7565_COLUMN_LSB | 0x00);
-        mr_send_command(mr, MR_ST7565_COLUMN_MSB | 0x00);
+        mr_send_command(mr, MR_ST7565_COLUMN_LSB | (start_column & 0xf));
+        mr_send_command(mr, MR_ST7565_COLUMN_MSB | (start_column >> 4));
 
         // Send data
         mr_set_command(mr, false);
-        uint8_t *buffer = (uint8_t *)mr->buffer +
-                          mr->display_width * pageIndex;
 
         mr_send_callback_t send = mr->send_callback;
 
-        for (int16_t i = 0;
-             i < mr->display_width;
+        for (int16_t i = start_column;
+             i < end_column;
              i++)
             send(buffer[i]);
     }
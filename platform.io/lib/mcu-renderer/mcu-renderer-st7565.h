@@ -80,6 +80,18 @@ void mr_st7565_init(mr_t *mr,
                     mr_set_command_callback_t set_command_callback,
                     mr_send_callback_t send_callback);
 
+/**
+ * Enables partial refreshes. The shadow framebuffer holds a copy of the
+ * display contents, so refreshes only send the changed column range of each
+ * page.
+ *
+ * @param mr The mcu-renderer instance.
+ * @param shadow_framebuffer A user-provided buffer of size
+ *                           (width * height / 8).
+ */
+void mr_st7565_set_shadow_framebuffer(mr_t *mr,
+                                      uint8_t *shadow_framebuffer);
+
 /**
  * Enables/disables the ST7565 display.
  *
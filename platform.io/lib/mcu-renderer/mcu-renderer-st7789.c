@@ -7,6 +7,8 @@
  * License: MIT
  */
 
+#include <stddef.h>
+
 #include "mcu-renderer-st7789.h"
 
 static const uint8_t mr_st7789_init_sequence[] = {
@@ -114,6 +116,20 @@ void mr_st7789_init(mr_t *mr,
     mr_set_chipselect(mr, false);
 }
 
+void mr_st7789_set_send_block(mr_t *mr,
+                              mr_send_block_callback_t send_block_callback,
+                              uint16_t *block_buffer,
+                              uint32_t block_buffer_size)
+{
+    mr->block_buffer = block_buffer;
+    mr->block_size = block_buffer_size / (2 * sizeof(uint16_t));
+    mr->block_index = 0;
+
+    mr->send_block_callback = mr->block_size
+                                  ? send_block_callback
+                                  : NULL;
+}
+
 void mr_st7789_set_display(mr_t *mr,
                            bool value)
 {
@@ -178,17 +194,61 @@ static bool mr_st7789_setup_buffer(mr_t *mr,
     return true;
 }
 
+static uint16_t *mr_st7789_get_block(mr_t *mr)
+{
+    uint16_t *block = mr->block_buffer +
+                      mr->block_index * mr->block_size;
+    mr->block_index ^= 1;
+
+    return block;
+}
+
+static uint16_t *mr_st7789_send_block(mr_t *mr,
+                                      uint16_t *block,
+                                      uint32_t count)
+{
+    mr->send_block_callback(block, count);
+
+    return mr_st7789_get_block(mr);
+}
+
 static void mr_st7789_draw_rectangle(mr_t *mr,
                                      const mr_rectangle_t *rectangle)
 {
     if (mr_st7789_setup_buffer(mr, rectangle))
     {
+        uint32_t count = (uint32_t)rectangle->width *
+                         (uint32_t)rectangle->height;
+
+        if (mr->send_block_callback)
+        {
+            // A constant block can be sent repeatedly
+            uint16_t *block = mr_st7789_get_block(mr);
+            uint32_t block_count = (count < mr->block_size)
+                                       ? count
+                                       : mr->block_size;
+
+            for (uint32_t i = 0; i < block_count; i++)
+                block[i] = mr->fill_color;
+
+            while (count)
+            {
+                if (block_count > count)
+                    block_count = count;
+
+                mr->send_block_callback(block, block_count);
+
+                count -= block_count;
+            }
+
+            mr_set_chipselect(mr, false);
+
+            return;
+        }
+
         mr_send_callback_t send16 = mr->send16_callback;
 
-        for (uint32_t i = 0;
-             i < ((uint32_t)rectangle->width *
-                  (uint32_t)rectangle->height);
-             i++)
+        for (uint32_t i = 0; i < count; i++)
             send16(mr->fill_color);
 
         mr_set_chipselect(mr, false);
@@ -202,6 +262,39 @@ static void mr_st7789_draw_bitmap(mr_t *mr,
 {
     if (mr_st7789_setup_buffer(mr, rectangle))
     {
+        if (mr->send_block_callback)
+        {
+            uint16_t *block = mr_st7789_get_block(mr);
+            uint32_t block_count = 0;
+
+            for (int16_t y = 0; y < rectangle->height; y++)
+            {
+                uint32_t source_index = 0;
+
+                for (int16_t x = 0; x < rectangle->width; x++)
+                {
+                    bool source_pixel = ((bitmap[source_index >> 3]) >> (source_index & 0b111)) & 0b1;
+                    source_index++;
+                    block[block_count++] = source_pixel ? mr->stroke_color : mr->fill_color;
+
+                    if (block_count == mr->block_size)
+                    {
+                        block = mr_st7789_send_block(mr, block, block_count);
+                        block_count = 0;
+                    }
+                }
+
+                bitmap += ((source_index + 7) >> 3);
+            }
+
+            if (block_count)
+                mr_st7789_send_block(mr, block, block_count);
+
+            mr_set_chipselect(mr, false);
+
+            return;
+        }
+
         mr_send_callback_t send16 = mr->send16_callback;
 
         mr_point_t position;
@@ -235,12 +328,32 @@ static void mr_st7789_draw_image(mr_t *mr,
 {
     if (mr_st7789_setup_buffer(mr, rectangle))
     {
+        uint32_t count = (uint32_t)rectangle->width *
+                         (uint32_t)rectangle->height;
+
+        if (mr->send_block_callback)
+        {
+            // Image data is sent in place
+            while (count)
+            {
+                uint32_t block_count = (count < mr->block_size)
+                                           ? count
+                                           : mr->block_size;
+
+                mr->send_block_callback(image, block_count);
+
+                image += block_count;
+                count -= block_count;
+            }
+
+            mr_set_chipselect(mr, false);
+
+            return;
+        }
+
         mr_send_callback_t send16 = mr->send16_callback;
 
-        for (uint32_t i = 0;
-             i < ((uint32_t)rectangle->width *
-                  (uint32_t)rectangle->height);
-             i++)
+        for (uint32_t i = 0; i < count; i++)
             send16(*image++);
 
         mr_set_chipselect(mr, false);
@@ -255,6 +368,36 @@ static void mr_st7789_draw_textbuffer(mr_t *mr,
 {
     if (mr_st7789_setup_buffer(mr, rectangle))
     {
+        if (mr->send_block_callback)
+        {
+            // Rasterize into one block while the other one is sent
+            uint16_t *block = mr_st7789_get_block(mr);
+            uint32_t block_count = 0;
+
+            for (int16_t y = 0; y < rectangle->height; y++)
+            {
+                for (int16_t x = 0; x < rectangle->width; x++)
+                {
+                    block[block_count++] = mr->blend_table[buffer[x]];
+
+                    if (block_count == mr->block_size)
+                    {
+                        block = mr_st7789_send_block(mr, block, block_count);
+                        block_count = 0;
+                    }
+                }
+
+                buffer += buffer_pitch;
+            }
+
+            if (block_count)
+                mr_st7789_send_block(mr, block, block_count);
+
+            mr_set_chipselect(mr, false);
+
+            return;
+        }
+
         mr_send_callback_t send16 = mr->send16_callback;
 
         mr_point_t position;
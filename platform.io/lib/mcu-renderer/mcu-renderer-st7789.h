@@ -139,6 +139,23 @@ void mr_st7789_init(mr_t *mr,
                     mr_send_callback_t send_callback,
                     mr_send_callback_t send16_callback);
 
+/**
+ * Enables block transfers of pixel data. The block buffer is split into two
+ * halves: pixels are rasterized into one half while the other is in flight.
+ * The send block callback may return before the transfer completes, but must
+ * wait for the previous transfer before starting a new one. The set
+ * chipselect and set command callbacks must wait for the last transfer.
+ *
+ * @param mr The mcu-renderer instance.
+ * @param send_block_callback A user-provided send 16-bit data block callback.
+ * @param block_buffer A user-provided buffer for the pixel data blocks.
+ * @param block_buffer_size The size of the user-provided buffer.
+ */
+void mr_st7789_set_send_block(mr_t *mr,
+                              mr_send_block_callback_t send_block_callback,
+                              uint16_t *block_buffer,
+                              uint32_t block_buffer_size);
+
 /**
  * Enables/disables the ST7789 display. Takes 120 ms to finish.
  *
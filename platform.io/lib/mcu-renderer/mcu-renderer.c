@@ -273,6 +273,12 @@ static inline bool mr_is_point_in_rect(const mr_point_t *p,
 
 // I/O
 
+// External definitions, for builds that don't inline
+extern inline void mr_set_chipselect(mr_t *mr, bool value);
+extern inline void mr_set_command(mr_t *mr, bool value);
+extern inline void mr_send(mr_t *mr, uint8_t value);
+extern inline void mr_send16(mr_t *mr, uint16_t value);
+
 void mr_send_command(mr_t *mr,
                      uint8_t command)
 {
@@ -530,14 +536,42 @@ static inline mr_color_t mr_fast_blend(uint32_t foreground_color,
 
 static void mr_update_blend_table(mr_t *mr)
 {
-    if ((mr->blend_table[0] == mr->fill_color) &&
-        (mr->blend_table[COLOR_BLEND_TABLE_SIZE - 1] == mr->stroke_color))
-        return;
+    // Blend tables of recent color pairs are kept, so switching back to
+    // them only swaps the table pointer
+    uint32_t use_count = ++mr->blend_table_use_count;
+    uint32_t least_recent_index = 0;
+
+    for (uint32_t i = 0; i < MCURENDERER_BLEND_TABLE_NUM; i++)
+    {
+        mr_blend_table_t *entry = &mr->blend_tables[i];
+
+        if ((entry->stroke_color == mr->stroke_color) &&
+            (entry->fill_color == mr->fill_color))
+        {
+            entry->last_use = use_count;
+            mr->blend_table = entry->table;
+
+            return;
+        }
+
+        // Wrap-safe age comparison
+        if ((use_count - entry->last_use) >
+            (use_count - mr->blend_tables[least_recent_index].last_use))
+            least_recent_index = i;
+    }
+
+    mr_blend_table_t *entry = &mr->blend_tables[least_recent_index];
+
+    entry->stroke_color = mr->stroke_color;
+    entry->fill_color = mr->fill_color;
+    entry->last_use = use_count;
 
     for (int i = 0; i < COLOR_BLEND_TABLE_SIZE; i++)
-        mr->blend_table[i] = mr_fast_blend(mr->stroke_color,
-                                           mr->fill_color,
-                                           i);
+        entry->table[i] = mr_fast_blend(mr->stroke_color,
+                                        mr->fill_color,
+                                        i);
+
+    mr->blend_table = entry->table;
 }
 
 static inline uint8_t mr_get_alpha(uint8_t pixel_bitnum,
@@ -565,115 +599,136 @@ static inline uint8_t mr_get_alpha(uint8_t pixel_bitnum,
     return (value + 1) >> 1;
 }
 
-#define mr_draw_glyph_template(name, init, loop, draw, advance)                         \
-    static void name                                                                    \
-    {                                                                                   \
-        const mr_font_header_t *font_header =                                           \
-            (const mr_font_header_t *)mr->font;                                         \
-                                                                                        \
-        uint8_t pixel_bitnum = font_header->glyph_pixel_bitnum;                         \
-        int16_t white_value = (1 << pixel_bitnum) - 1;                                  \
-                                                                                        \
-        mr_bitstream_t *bitstream = &mr->glyph.bitstream;                               \
-                                                                                        \
-        mr_rectangle_t glyph_rectangle = {                                              \
-            mr->glyph.boundingbox_left,                                                 \
-            mr->glyph.boundingbox_bottom + mr->glyph.boundingbox_height,                \
-            mr->glyph.boundingbox_width,                                                \
-            mr->glyph.boundingbox_height};                                              \
-                                                                                        \
-        mr_point_t glyph_position = {                                                   \
-            0,                                                                          \
-            0};                                                                         \
-                                                                                        \
-        uint32_t repeat_length;                                                         \
-        uint32_t repeat_num;                                                            \
-        uint32_t repeat_index = 0;                                                      \
-        mr_bitstream_t repeat_bitstream = {                                             \
-            NULL,                                                                       \
-            0};                                                                         \
-                                                                                        \
-        init;                                                                           \
-                                                                                        \
-        while (glyph_position.y < glyph_rectangle.height)                               \
-        {                                                                               \
-            uint8_t value = mr_get_unsigned_bits(bitstream, pixel_bitnum);              \
-                                                                                        \
-            uint16_t runlength;                                                         \
-                                                                                        \
-            if (!value ||                                                               \
-                (value == white_value))                                                 \
-            {                                                                           \
-                int8_t runlength_bitnum = !value                                        \
-                                              ? font_header->glyph_repeat_black_bitnum  \
-                                              : font_header->glyph_repeat_white_bitnum; \
-                                                                                        \
-                uint16_t runlength_remainder =                                          \
-                    mr_get_unsigned_bits(bitstream, runlength_bitnum);                  \
-                                                                                        \
-                uint16_t runlength_quotient = 0;                                        \
-                while (mr_get_unsigned_bits(bitstream, 1))                              \
-                    runlength_quotient++;                                               \
-                                                                                        \
-                runlength = (runlength_quotient << runlength_bitnum) +                  \
-                            runlength_remainder;                                        \
-                                                                                        \
-                if (!value)                                                             \
-                {                                                                       \
-                    if (!runlength)                                                     \
-                    {                                                                   \
-                        repeat_length = 2;                                              \
-                        while (mr_get_unsigned_bits(bitstream, 1))                      \
-                            repeat_length++;                                            \
-                                                                                        \
-                        repeat_num = 1;                                                 \
-                        while (mr_get_unsigned_bits(bitstream, 1))                      \
-                            repeat_num++;                                               \
-                                                                                        \
-                        repeat_index = repeat_length;                                   \
-                        repeat_bitstream = *bitstream;                                  \
-                                                                                        \
-                        continue;                                                       \
-                    }                                                                   \
-                }                                                                       \
-                else                                                                    \
-                    runlength++;                                                        \
-            }                                                                           \
-            else                                                                        \
-                runlength = 1;                                                          \
-                                                                                        \
-            loop;                                                                       \
-                                                                                        \
-            while (runlength--)                                                         \
-            {                                                                           \
-                draw;                                                                   \
-                                                                                        \
-                glyph_position.x++;                                                     \
-                                                                                        \
-                if (glyph_position.x >= glyph_rectangle.width)                          \
-                {                                                                       \
-                    advance;                                                            \
-                                                                                        \
-                    glyph_position.x = 0;                                               \
-                    glyph_position.y++;                                                 \
-                }                                                                       \
-            }                                                                           \
-                                                                                        \
-            if (repeat_index)                                                           \
-            {                                                                           \
-                repeat_index--;                                                         \
-                                                                                        \
-                if (!repeat_index &&                                                    \
-                    repeat_num)                                                         \
-                {                                                                       \
-                    repeat_num--;                                                       \
-                                                                                        \
-                    repeat_index = repeat_length;                                       \
-                                                                                        \
-                    *bitstream = repeat_bitstream;                                      \
-                }                                                                       \
-            }                                                                           \
-        }                                                                               \
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+#define mr_get_glyph_runs(mr) ((mr)->glyph.runs)
+#else
+#define mr_get_glyph_runs(mr) ((const uint8_t *)NULL)
+#endif
+
+#define mr_draw_glyph_template(name, init, loop, draw, advance)                             \
+    static void name                                                                        \
+    {                                                                                       \
+        const mr_font_header_t *font_header =                                               \
+            (const mr_font_header_t *)mr->font;                                             \
+                                                                                            \
+        uint8_t pixel_bitnum = font_header->glyph_pixel_bitnum;                             \
+        int16_t white_value = (1 << pixel_bitnum) - 1;                                      \
+                                                                                            \
+        mr_bitstream_t *bitstream = &mr->glyph.bitstream;                                   \
+        const uint8_t *runs = mr_get_glyph_runs(mr);                                        \
+                                                                                            \
+        mr_rectangle_t glyph_rectangle = {                                                  \
+            mr->glyph.boundingbox_left,                                                     \
+            mr->glyph.boundingbox_bottom + mr->glyph.boundingbox_height,                    \
+            mr->glyph.boundingbox_width,                                                    \
+            mr->glyph.boundingbox_height};                                                  \
+                                                                                            \
+        mr_point_t glyph_position = {                                                       \
+            0,                                                                              \
+            0};                                                                             \
+                                                                                            \
+        uint32_t repeat_length;                                                             \
+        uint32_t repeat_num;                                                                \
+        uint32_t repeat_index = 0;                                                          \
+        mr_bitstream_t repeat_bitstream = {                                                 \
+            NULL,                                                                           \
+            0};                                                                             \
+                                                                                            \
+        init;                                                                               \
+                                                                                            \
+        while (glyph_position.y < glyph_rectangle.height)                                   \
+        {                                                                                   \
+            uint8_t value;                                                                  \
+            uint16_t runlength;                                                             \
+                                                                                            \
+            if (runs)                                                                       \
+            {                                                                               \
+                value = *runs >> 4;                                                         \
+                runlength = *runs++ & 0xf;                                                  \
+                                                                                            \
+                if (runlength == 0xf)                                                       \
+                    runlength = *runs++;                                                    \
+                else                                                                        \
+                    runlength++;                                                            \
+            }                                                                               \
+            else                                                                            \
+            {                                                                               \
+                value = mr_get_unsigned_bits(bitstream, pixel_bitnum);                      \
+                                                                                            \
+                if (!value ||                                                               \
+                    (value == white_value))                                                 \
+                {                                                                           \
+                    int8_t runlength_bitnum = !value                                        \
+                                                  ? font_header->glyph_repeat_black_bitnum  \
+                                                  : font_header->glyph_repeat_white_bitnum; \
+                                                                                            \
+                    uint16_t runlength_remainder =                                          \
+                        mr_get_unsigned_bits(bitstream, runlength_bitnum);                  \
+                                                                                            \
+                    uint16_t runlength_quotient = 0;                                        \
+                    while (mr_get_unsigned_bits(bitstream, 1))                              \
+                        runlength_quotient++;                                               \
+                                                                                            \
+                    runlength = (runlength_quotient << runlength_bitnum) +                  \
+                                runlength_remainder;                                        \
+                                                                                            \
+                    if (!value)                                                             \
+                    {                                                                       \
+                        if (!runlength)                                                     \
+                        {                                                                   \
+                            repeat_length = 2;                                              \
+                            while (mr_get_unsigned_bits(bitstream, 1))                      \
+                                repeat_length++;                                            \
+                                                                                            \
+                            repeat_num = 1;                                                 \
+                            while (mr_get_unsigned_bits(bitstream, 1))                      \
+                                repeat_num++;                                               \
+                                                                                            \
+                            repeat_index = repeat_length;                                   \
+                            repeat_bitstream = *bitstream;                                  \
+                                                                                            \
+                            continue;                                                       \
+                        }                                                                   \
+                    }                                                                       \
+                    else                                                                    \
+                        runlength++;                                                        \
+                }                                                                           \
+                else                                                                        \
+                    runlength = 1;                                                          \
+            }                                                                               \
+                                                                                            \
+            loop;                                                                           \
+                                                                                            \
+            while (runlength--)                                                             \
+            {                                                                               \
+                draw;                                                                       \
+                                                                                            \
+                glyph_position.x++;                                                         \
+                                                                                            \
+                if (glyph_position.x >= glyph_rectangle.width)                              \
+                {                                                                           \
+                    advance;                                                                \
+                                                                                            \
+                    glyph_position.x = 0;                                                   \
+                    glyph_position.y++;                                                     \
+                }                                                                           \
+            }                                                                               \
+                                                                                            \
+            if (repeat_index)                                                               \
+            {                                                                               \
+                repeat_index--;                                                             \
+                                                                                            \
+                if (!repeat_index &&                                                        \
+                    repeat_num)                                                             \
+                {                                                                           \
+                    repeat_num--;                                                           \
+                                                                                            \
+                    repeat_index = repeat_length;                                           \
+                                                                                            \
+                    *bitstream = repeat_bitstream;                                          \
+                }                                                                           \
+            }                                                                               \
+        }                                                                                   \
     }
 
 //
@@ -802,6 +857,55 @@ mr_draw_glyph_template(mr_draw_glyph_textbuffer_prototype,
                        mr_draw_glyph_textbuffer_draw,
                        mr_draw_glyph_textbuffer_advance);
 
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+
+//
+
+#define mr_decode_glyph_runs_prototype                    \
+    mr_decode_glyph_runs(mr_t *mr,                        \
+                         uint8_t *runs_buffer,            \
+                         uint32_t runs_buffer_size,       \
+                         uint32_t *runs_size)
+
+#define mr_decode_glyph_runs_init \
+    *runs_size = 0;
+
+// Runs are stored as value (high nibble) and length - 1 (low nibble), or
+// as value, 0xf and a length byte for runs of 15 pixels or more
+
+#define mr_decode_glyph_runs_loop                                         \
+    for (uint16_t remaining = runlength; remaining;)                      \
+    {                                                                     \
+        uint8_t length = (remaining > 0xff) ? 0xff : remaining;           \
+        uint32_t size = (length < 0xf) ? 1 : 2;                           \
+                                                                          \
+        if ((*runs_size + size) <= runs_buffer_size)                      \
+        {                                                                 \
+            if (size == 1)                                                \
+                runs_buffer[*runs_size] = (value << 4) | (length - 1);    \
+            else                                                          \
+            {                                                             \
+                runs_buffer[*runs_size] = (value << 4) | 0xf;             \
+                runs_buffer[*runs_size + 1] = length;                     \
+            }                                                             \
+        }                                                                 \
+                                                                          \
+        *runs_size += size;                                               \
+        remaining -= length;                                              \
+    }
+
+#define mr_decode_glyph_runs_draw
+
+#define mr_decode_glyph_runs_advance
+
+mr_draw_glyph_template(mr_decode_glyph_runs_prototype,
+                       mr_decode_glyph_runs_init,
+                       mr_decode_glyph_runs_loop,
+                       mr_decode_glyph_runs_draw,
+                       mr_decode_glyph_runs_advance);
+
+#endif
+
 // Text processing
 
 static bool mr_get_glyph(mr_t *mr,
@@ -875,6 +979,150 @@ static bool mr_get_glyph(mr_t *mr,
     return false;
 }
 
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+
+// Glyph cache: decoded runs of recently drawn glyphs, packed at the start
+// of the cache buffer in entry order
+
+static uint32_t mr_get_glyph_cache_used_size(mr_t *mr)
+{
+    if (!mr->glyph_cache_entry_num)
+        return 0;
+
+    const mr_glyph_cache_entry_t *last_entry =
+        &mr->glyph_cache_entries[mr->glyph_cache_entry_num - 1];
+
+    return last_entry->offset + last_entry->size;
+}
+
+static uint32_t mr_get_least_recent_glyph_cache_entry(mr_t *mr)
+{
+    uint32_t use_count = mr->glyph_cache_use_count;
+    uint32_t least_recent_index = 0;
+
+    for (uint32_t i = 1; i < mr->glyph_cache_entry_num; i++)
+    {
+        // Wrap-safe age comparison
+        if ((use_count - mr->glyph_cache_entries[i].last_use) >
+            (use_count - mr->glyph_cache_entries[least_recent_index].last_use))
+            least_recent_index = i;
+    }
+
+    return least_recent_index;
+}
+
+static void mr_evict_glyph_cache_entry(mr_t *mr,
+                                       uint32_t index)
+{
+    mr_glyph_cache_entry_t *entries = mr->glyph_cache_entries;
+    uint32_t offset = entries[index].offset;
+    uint32_t size = entries[index].size;
+    uint32_t used_size = mr_get_glyph_cache_used_size(mr);
+
+    memmove(mr->glyph_cache + offset,
+            mr->glyph_cache + offset + size,
+            used_size - (offset + size));
+
+    for (uint32_t i = index + 1; i < mr->glyph_cache_entry_num; i++)
+    {
+        entries[i - 1] = entries[i];
+        entries[i - 1].offset -= size;
+    }
+
+    mr->glyph_cache_entry_num--;
+}
+
+static bool mr_get_cached_glyph(mr_t *mr,
+                                mr_charcode charcode)
+{
+    uint32_t use_count = ++mr->glyph_cache_use_count;
+
+    for (uint32_t i = 0; i < mr->glyph_cache_entry_num; i++)
+    {
+        mr_glyph_cache_entry_t *entry = &mr->glyph_cache_entries[i];
+
+        if (entry->charcode == charcode)
+        {
+            entry->last_use = use_count;
+
+            mr->glyph = entry->glyph;
+            mr->glyph.runs = mr->glyph_cache + entry->offset;
+
+            return true;
+        }
+    }
+
+    if (!mr_get_glyph(mr, charcode))
+        return false;
+
+    if (mr->glyph_cache_entry_num >= MCURENDERER_GLYPH_CACHE_ENTRY_NUM)
+        mr_evict_glyph_cache_entry(mr,
+                                   mr_get_least_recent_glyph_cache_entry(mr));
+
+    // Decoding consumes the glyph bitstream
+    mr_bitstream_t bitstream = mr->glyph.bitstream;
+
+    uint32_t offset = mr_get_glyph_cache_used_size(mr);
+    uint32_t size;
+    mr_decode_glyph_runs(mr,
+                         mr->glyph_cache + offset,
+                         mr->glyph_cache_size - offset,
+                         &size);
+
+    mr->glyph.bitstream = bitstream;
+
+    // Glyphs larger than the cache are drawn from the font
+    if (size > mr->glyph_cache_size)
+        return true;
+
+    if ((offset + size) > mr->glyph_cache_size)
+    {
+        while ((offset + size) > mr->glyph_cache_size)
+        {
+            mr_evict_glyph_cache_entry(mr,
+                                       mr_get_least_recent_glyph_cache_entry(mr));
+
+            offset = mr_get_glyph_cache_used_size(mr);
+        }
+
+        mr_decode_glyph_runs(mr,
+                             mr->glyph_cache + offset,
+                             mr->glyph_cache_size - offset,
+                             &size);
+
+        mr->glyph.bitstream = bitstream;
+    }
+
+    mr_glyph_cache_entry_t *entry =
+        &mr->glyph_cache_entries[mr->glyph_cache_entry_num++];
+
+    entry->charcode = charcode;
+    entry->last_use = use_count;
+    entry->offset = offset;
+    entry->size = size;
+    entry->glyph = mr->glyph;
+
+    mr->glyph.runs = mr->glyph_cache + offset;
+
+    return true;
+}
+
+#endif
+
+static bool mr_get_draw_glyph(mr_t *mr,
+                              mr_charcode charcode)
+{
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+    mr->glyph.runs = NULL;
+
+    if (mr->glyph_cache &&
+        (mr->font == mr->glyph_cache_font))
+        return mr_get_cached_glyph(mr, charcode);
+#endif
+
+    return mr_get_glyph(mr, charcode);
+}
+
 static int16_t mr_get_string_width(mr_t *mr,
                                    const uint8_t *str,
                                    mr_get_charcode_callback_t get_charcode_callback)
@@ -895,6 +1143,42 @@ static int16_t mr_get_string_width(mr_t *mr,
     return width;
 }
 
+static uint32_t mr_get_string_fit(mr_t *mr,
+                                  const uint8_t *str,
+                                  int16_t max_width,
+                                  uint32_t max_length,
+                                  int16_t *width,
+                                  mr_get_charcode_callback_t get_charcode_callback)
+{
+    const uint8_t *str_start = str;
+    const uint8_t *fit_end = str;
+    int16_t fit_width = 0;
+    int16_t pen_x = 0;
+
+    while (true)
+    {
+        mr_charcode charcode = get_charcode_callback((uint8_t **)&str);
+
+        if (!charcode)
+            break;
+
+        if (mr_get_glyph(mr, charcode))
+            pen_x += mr->glyph.advance;
+
+        if ((pen_x > max_width) ||
+            ((uint32_t)(str - str_start) > max_length))
+            break;
+
+        fit_end = str;
+        fit_width = pen_x;
+    }
+
+    if (width)
+        *width = fit_width;
+
+    return fit_end - str_start;
+}
+
 static inline mr_rectangle_t mr_get_font_boundingbox(mr_t *mr)
 {
     const mr_font_header_t *font_header =
@@ -929,7 +1213,7 @@ static inline mr_rectangle_t mr_get_font_boundingbox(mr_t *mr)
             if (!charcode)                                                  \
                 break;                                                      \
                                                                             \
-            if (!mr_get_glyph(mr, charcode))                                \
+            if (!mr_get_draw_glyph(mr, charcode))                           \
                 continue;                                                   \
                                                                             \
             callback(mr,                                                    \
@@ -990,7 +1274,7 @@ void mr_draw_string_textbuffer(mr_t *mr,
             draw_buffer = true;
         else
         {
-            if (!mr_get_glyph(mr, charcode))
+            if (!mr_get_draw_glyph(mr, charcode))
                 continue;
 
             if (!text_rectangle.width)
@@ -1138,6 +1422,28 @@ void mr_set_font(mr_t *mr,
     mr->font = font;
 }
 
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+void mr_set_glyph_cache(mr_t *mr,
+                        const uint8_t *font,
+                        uint8_t *buffer,
+                        uint32_t buffer_size)
+{
+    // Entry offsets are 16-bit
+    if (buffer_size > 0xffff)
+        buffer_size = 0xffff;
+
+    // Cached runs store pixel values in 4 bits
+    const mr_font_header_t *font_header = (const mr_font_header_t *)font;
+    if (font_header->glyph_pixel_bitnum > 4)
+        buffer = NULL;
+
+    mr->glyph_cache_font = font;
+    mr->glyph_cache = buffer;
+    mr->glyph_cache_size = buffer_size;
+    mr->glyph_cache_entry_num = 0;
+}
+#endif
+
 void mr_draw_text(mr_t *mr,
                   const char *str,
                   const mr_rectangle_t *rectangle,
@@ -1198,6 +1504,20 @@ int16_t mr_get_utf16_text_width(mr_t *mr,
                                mr_decode_utf16);
 }
 
+uint32_t mr_get_utf8_text_fit(mr_t *mr,
+                              const uint8_t *str,
+                              int16_t max_width,
+                              uint32_t max_length,
+                              int16_t *width)
+{
+    return mr_get_string_fit(mr,
+                             str,
+                             max_width,
+                             max_length,
+                             width,
+                             mr_decode_utf8);
+}
+
 int16_t mr_get_cap_height(mr_t *mr)
 {
     const mr_font_header_t *font_header =
@@ -27,6 +27,15 @@ extern "C" {
 #define MCURENDERER_IMAGE_SUPPORT
 #endif
 
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT) && \
+    !defined(MCURENDERER_GLYPH_CACHE_ENTRY_NUM)
+#define MCURENDERER_GLYPH_CACHE_ENTRY_NUM 16
+#endif
+
+#if !defined(MCURENDERER_BLEND_TABLE_NUM)
+#define MCURENDERER_BLEND_TABLE_NUM 8
+#endif
+
 // Instance
 
 struct mr_t_;
@@ -39,6 +48,14 @@ typedef uint16_t mr_color_t;
 
 #define COLOR_BLEND_TABLE_SIZE ((1 << 5) + 1)
 
+typedef struct
+{
+    mr_color_t stroke_color;
+    mr_color_t fill_color;
+    uint32_t last_use;
+    mr_color_t table[COLOR_BLEND_TABLE_SIZE];
+} mr_blend_table_t;
+
 /**
  * Macro for converting RGB888 colors to RGB565 colors using bit truncation. Best for UIs.
  *
@@ -123,8 +140,23 @@ typedef struct
     uint8_t boundingbox_width;
     uint8_t boundingbox_height;
     uint8_t advance;
+
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+    const uint8_t *runs;
+#endif
 } mr_glyph_t;
 
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+typedef struct
+{
+    uint32_t charcode;
+    uint32_t last_use;
+    uint16_t offset;
+    uint16_t size;
+    mr_glyph_t glyph;
+} mr_glyph_cache_entry_t;
+#endif
+
 typedef uint32_t mr_charcode;
 
 typedef mr_charcode (*mr_get_charcode_callback_t)(uint8_t **str);
@@ -166,6 +198,8 @@ typedef void (*mr_set_reset_callback_t)(bool value);
 typedef void (*mr_set_chipselect_callback_t)(bool value);
 typedef void (*mr_set_command_callback_t)(bool value);
 typedef void (*mr_send_callback_t)(uint16_t value);
+typedef void (*mr_send_block_callback_t)(const uint16_t *buffer,
+                                         uint32_t count);
 
 void mr_send_command(mr_t *mr,
                      uint8_t command);
@@ -231,6 +265,7 @@ struct mr_t_
     mr_set_command_callback_t set_command_callback;
     mr_send_callback_t send_callback;
     mr_send_callback_t send16_callback;
+    mr_send_block_callback_t send_block_callback;
 
     int16_t display_width;
     int16_t display_height;
@@ -239,13 +274,30 @@ struct mr_t_
 
     void *buffer;
     uint32_t buffer_size;
+    void *shadow_buffer;
+
+    uint16_t *block_buffer;
+    uint32_t block_size;
+    uint32_t block_index;
 
     mr_color_t stroke_color;
     mr_color_t fill_color;
 
-    mr_color_t blend_table[COLOR_BLEND_TABLE_SIZE];
+    const mr_color_t *blend_table;
+    uint32_t blend_table_use_count;
+    mr_blend_table_t blend_tables[MCURENDERER_BLEND_TABLE_NUM];
+
     const uint8_t *font;
     mr_glyph_t glyph;
+
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+    const uint8_t *glyph_cache_font;
+    uint8_t *glyph_cache;
+    uint32_t glyph_cache_size;
+    uint32_t glyph_cache_use_count;
+    uint32_t glyph_cache_entry_num;
+    mr_glyph_cache_entry_t glyph_cache_entries[MCURENDERER_GLYPH_CACHE_ENTRY_NUM];
+#endif
 };
 
 void mr_init(mr_t *mr);
@@ -334,6 +386,26 @@ void mr_draw_image(mr_t *mr,
 void mr_set_font(mr_t *mr,
                  const uint8_t *font);
 
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+/**
+ * Sets a RAM cache for the glyphs of a font.
+ *
+ * Drawn glyphs of the font are decoded once into the buffer and redrawn
+ * from there, evicting the least recently used glyphs when full. Fonts
+ * with more than 4 bits per pixel are not cached. Requires
+ * MCURENDERER_GLYPH_CACHE_SUPPORT.
+ *
+ * @param mr The mcu-renderer instance.
+ * @param font The cached font.
+ * @param buffer The cache buffer.
+ * @param buffer_size The cache buffer size (up to 65535 bytes).
+ */
+void mr_set_glyph_cache(mr_t *mr,
+                        const uint8_t *font,
+                        uint8_t *buffer,
+                        uint32_t buffer_size);
+#endif
+
 /**
  * Draws a C-string.
  *
@@ -412,6 +484,27 @@ int16_t mr_get_utf8_text_width(mr_t *mr,
 int16_t mr_get_utf16_text_width(mr_t *mr,
                                 const uint16_t *str);
 
+/**
+ * Returns the byte length of the longest prefix of a UTF-8 string that
+ * fits a pixel width.
+ *
+ * The string is measured in a single pass, stopping at the first glyph
+ * that does not fit.
+ *
+ * @param mr The mcu-renderer instance.
+ * @param str The string.
+ * @param max_width The available pixel width.
+ * @param max_length The maximum prefix length in bytes.
+ * @param width If not NULL, receives the pixel width of the prefix.
+ *
+ * @return The prefix length in bytes, ending at a character boundary.
+ */
+uint32_t mr_get_utf8_text_fit(mr_t *mr,
+                              const uint8_t *str,
+                              int16_t max_width,
+                              uint32_t max_length,
+                              int16_t *width);
+
 /**
  * Returns the current font's cap height (height of uppercase A).
  *
@@ -2016,6 +2016,25 @@ __STATIC_INLINE bool usart_is_transmit_interrupt_enabled(const USART_TypeDef *ba
 #endif
 }
 
+__STATIC_INLINE void usart_enable_transmit_dma(USART_TypeDef *base)
+{
+    set_bits(base->CR3, USART_CR3_DMAT);
+}
+
+__STATIC_INLINE void usart_disable_transmit_dma(USART_TypeDef *base)
+{
+    clear_bits(base->CR3, USART_CR3_DMAT);
+}
+
+__STATIC_INLINE uint32_t usart_get_transmit_data_address(USART_TypeDef *base)
+{
+#if defined(STM32F0) || defined(STM32G0) || defined(STM32L4)
+    return (uint32_t)&base->TDR;
+#elif defined(STM32F1)
+    return (uint32_t)&base->DR;
+#endif
+}
+
 __STATIC_INLINE bool usart_is_receive_ready(const USART_TypeDef *base)
 {
 #if defined(STM32F0) || defined(STM32L4)
@@ -2122,6 +2141,28 @@ __STATIC_INLINE void spi_enable(SPI_TypeDef *base)
     set_bits(base->CR1, SPI_CR1_SPE);
 }
 
+__STATIC_INLINE void spi_disable(SPI_TypeDef *base)
+{
+    clear_bits(base->CR1, SPI_CR1_SPE);
+}
+
+#if defined(STM32F1)
+__STATIC_INLINE void spi_set_frame16(SPI_TypeDef *base,
+                                     bool value)
+{
+    // SPI must be disabled
+    if (value)
+        set_bits(base->CR1, SPI_CR1_DFF);
+    else
+        clear_bits(base->CR1, SPI_CR1_DFF);
+}
+#endif
+
+__STATIC_INLINE void spi_enable_tx_dma(SPI_TypeDef *base)
+{
+    set_bits(base->CR2, SPI_CR2_TXDMAEN);
+}
+
 // DMA
 
 __STATIC_INLINE void dma_setup_memory32_to_peripheral32(DMA_Channel_TypeDef *channel, uint32_t dest, uint32_t source, uint32_t count)
@@ -2135,6 +2176,37 @@ __STATIC_INLINE void dma_setup_memory32_to_peripheral32(DMA_Channel_TypeDef *cha
     channel->CPAR = dest;
 }
 
+__STATIC_INLINE void dma_setup_memory16_to_peripheral16(DMA_Channel_TypeDef *channel, uint32_t dest, uint32_t source, uint32_t count)
+{
+    channel->CCR = DMA_CCR_DIR |
+                   DMA_CCR_MINC |
+                   (0b01 << DMA_CCR_PSIZE_Pos) |
+                   (0b01 << DMA_CCR_MSIZE_Pos);
+    channel->CNDTR = count;
+    channel->CMAR = source;
+    channel->CPAR = dest;
+}
+
+__STATIC_INLINE void dma_setup_memory8_to_peripheral8(DMA_Channel_TypeDef *channel, uint32_t dest, uint32_t source, uint32_t count)
+{
+    channel->CCR = DMA_CCR_DIR |
+                   DMA_CCR_MINC;
+    channel->CNDTR = count;
+    channel->CMAR = source;
+    channel->CPAR = dest;
+}
+
+__STATIC_INLINE void dma_enable_transfer_complete_interrupt(DMA_Channel_TypeDef *channel)
+{
+    set_bits(channel->CCR, DMA_CCR_TCIE);
+}
+
+__STATIC_INLINE void dma_clear_interrupt_flags(DMA_TypeDef *base, uint32_t channel_index)
+{
+    // Channel indices start at 1
+    base->IFCR = (0xfUL << (4 * (channel_index - 1)));
+}
+
 __STATIC_INLINE bool dma_is_active(const DMA_Channel_TypeDef *channel)
 {
     return (channel->CNDTR != 0);
@@ -0,0 +1,180 @@
+/*
+ * Rad Pro
+ * Headless benchmark
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(BENCHMARK)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../bench/bench.h"
+#include "../measurements/datalog.h"
+#include "../measurements/history.h"
+#include "../peripherals/tube.h"
+#include "../system/events.h"
+#include "../system/settings.h"
+
+#define BENCH_SIMULATED_TIME_DEFAULT (60 * 60)
+#define BENCH_LOADHISTORY_NUM 16
+#define BENCH_CALIBRATION_NUM 100000
+
+static const char *const benchProbeNames[] = {
+    "onPulseTick",
+    "updatePulses",
+    "updateHistory",
+    "updateDatalog",
+    "loadHistory",
+};
+
+static struct
+{
+    uint64_t probeTime[BENCH_PROBE_NUM];
+    uint64_t probeCount[BENCH_PROBE_NUM];
+    uint64_t probeOverhead;
+} bench;
+
+// Probes
+
+uint64_t getBenchTime(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void addBenchProbeTime(BenchProbe probe, uint64_t startTime)
+{
+    bench.probeTime[probe] += getBenchTime() - startTime;
+    bench.probeCount[probe]++;
+}
+
+static void resetBenchProbes(void)
+{
+    for (uint32_t i = 0; i < BENCH_PROBE_NUM; i++)
+    {
+        bench.probeTime[i] = 0;
+        bench.probeCount[i] = 0;
+    }
+}
+
+static void calibrateBenchProbes(void)
+{
+    resetBenchProbes();
+
+    for (uint32_t i = 0; i < BENCH_CALIBRATION_NUM; i++)
+        BENCH_PROBE(BENCH_PROBE_ONPULSETICK, );
+
+    bench.probeOverhead = bench.probeTime[BENCH_PROBE_ONPULSETICK] / BENCH_CALIBRATION_NUM;
+
+    resetBenchProbes();
+}
+
+// Report
+
+uint32_t getBenchEnvironmentValue(const char *name, uint32_t defaultValue)
+{
+    const char *value = getenv(name);
+
+    return value ? (uint32_t)strtoul(value, NULL, 10) : defaultValue;
+}
+
+static double getBenchProbeNsPerCall(BenchProbe probe)
+{
+    if (!bench.probeCount[probe])
+        return 0;
+
+    double nsPerCall = (double)bench.probeTime[probe] / bench.probeCount[probe] -
+                       bench.probeOverhead;
+
+    return (nsPerCall > 0) ? nsPerCall : 0;
+}
+
+static void printBenchProbe(BenchProbe probe,
+                            uint32_t tickNum,
+                            uint32_t heartbeatNum)
+{
+    double nsPerCall = getBenchProbeNsPerCall(probe);
+    double callNum = (double)bench.probeCount[probe];
+
+    printf("%-16s %12llu calls %12.1f ns/call %12.2f ns/tick %12.1f ns/heartbeat\n",
+           benchProbeNames[probe],
+           (unsigned long long)bench.probeCount[probe],
+           nsPerCall,
+           tickNum ? nsPerCall * callNum / tickNum : 0,
+           heartbeatNum ? nsPerCall * callNum / heartbeatNum : 0);
+}
+
+// Benchmark
+
+void simulateBenchTicks(uint32_t tickNum)
+{
+    // Tick loop, as driven by the simulator main loop
+    for (uint32_t i = 0; i < tickNum; i++)
+    {
+        currentTick++;
+        onTick();
+
+        updateEvents();
+    }
+}
+
+void runBenchmark(void)
+{
+    uint32_t simulatedTime = getBenchEnvironmentValue("RADPRO_BENCH_TIME",
+                                                      BENCH_SIMULATED_TIME_DEFAULT);
+    uint32_t tickNum = simulatedTime * SYSTICK_FREQUENCY;
+
+    settings.loggingMode = getBenchEnvironmentValue("RADPRO_BENCH_LOGGINGMODE",
+                                                    DATALOG_LOGGINGMODE_1_SECOND);
+    if (settings.loggingMode >= DATALOG_LOGGINGMODE_NUM)
+        settings.loggingMode = DATALOG_LOGGINGMODE_1_SECOND;
+
+    calibrateBenchProbes();
+
+    uint64_t startTime = getBenchTime();
+
+    simulateBenchTicks(tickNum);
+
+    uint64_t elapsedTime = getBenchTime() - startTime;
+
+    printf("Simulated %u s (%u ticks) in %.3f s, %.1fx real time\n",
+           simulatedTime,
+           tickNum,
+           elapsedTime * 1E-9,
+           elapsedTime ? (double)simulatedTime * 1E9 / elapsedTime : 0);
+    printf("Pulses: %u (%.2f cps)\n",
+           tubePulseCount,
+           simulatedTime ? (double)tubePulseCount / simulatedTime : 0);
+    printf("%-16s %12.1f ns/tick %12.1f ns/heartbeat\n",
+           "total",
+           tickNum ? (double)elapsedTime / tickNum : 0,
+           simulatedTime ? (double)elapsedTime / simulatedTime : 0);
+    printf("Probe overhead: %llu ns/call (subtracted)\n",
+           (unsigned long long)bench.probeOverhead);
+
+    // updatePulses includes updateHistory
+    for (uint32_t i = 0; i < BENCH_PROBE_LOADHISTORY; i++)
+        printBenchProbe(i, tickNum, simulatedTime);
+
+    // History rebuild from the data log written above
+    bench.probeTime[BENCH_PROBE_LOADHISTORY] = 0;
+    bench.probeCount[BENCH_PROBE_LOADHISTORY] = 0;
+
+    eraseSavedHistory();
+    for (uint32_t i = 0; i < BENCH_LOADHISTORY_NUM; i++)
+        BENCH_PROBE(BENCH_PROBE_LOADHISTORY, loadHistory());
+
+    printf("%-16s %12llu calls %12.1f ns/call\n",
+           benchProbeNames[BENCH_PROBE_LOADHISTORY],
+           (unsigned long long)bench.probeCount[BENCH_PROBE_LOADHISTORY],
+           getBenchProbeNsPerCall(BENCH_PROBE_LOADHISTORY));
+}
+
+#endif
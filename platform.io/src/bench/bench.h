@@ -0,0 +1,51 @@
+/*
+ * Rad Pro
+ * Headless benchmark
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if !defined(BENCH_H)
+#define BENCH_H
+
+#include <stdint.h>
+
+#if defined(BENCHMARK)
+
+typedef enum
+{
+    BENCH_PROBE_ONPULSETICK,
+    BENCH_PROBE_UPDATEPULSES,
+    BENCH_PROBE_UPDATEHISTORY,
+    BENCH_PROBE_UPDATEDATALOG,
+    BENCH_PROBE_LOADHISTORY,
+
+    BENCH_PROBE_NUM,
+} BenchProbe;
+
+uint64_t getBenchTime(void);
+void addBenchProbeTime(BenchProbe probe, uint64_t startTime);
+
+uint32_t getBenchEnvironmentValue(const char *name, uint32_t defaultValue);
+void simulateBenchTicks(uint32_t tickNum);
+
+#define BENCH_PROBE(probe, statement)                  \
+    do                                                 \
+    {                                                  \
+        uint64_t benchProbeStartTime = getBenchTime(); \
+        statement;                                     \
+        addBenchProbeTime(probe, benchProbeStartTime); \
+    } while (0)
+
+void runBenchmark(void);
+void runRenderBenchmark(void);
+
+#else
+
+#define BENCH_PROBE(probe, statement) statement
+
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Rad Pro
+ * Headless benchmark display
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(BENCHMARK)
+
+#include <mcu-renderer-framebuffer.h>
+
+#include "../peripherals/display.h"
+#include "../peripherals/led.h"
+#include "../peripherals/vibrator.h"
+
+// Display
+
+extern mr_t mr;
+
+static bool displayEnabled;
+
+void initDisplay(void)
+{
+    // mcu-renderer, drawing into an offscreen framebuffer
+    mr_framebuffer_init(&mr,
+                        DISPLAY_WIDTH,
+                        DISPLAY_HEIGHT,
+#if defined(DISPLAY_MONOCHROME)
+                        MR_FRAMEBUFFER_DISPLAY_TYPE_MONOCHROME
+#elif defined(DISPLAY_COLOR)
+                        MR_FRAMEBUFFER_DISPLAY_TYPE_COLOR
+#endif
+    );
+}
+
+void setDisplayEnabled(bool value)
+{
+    displayEnabled = value;
+}
+
+bool isDisplayEnabled(void)
+{
+    return displayEnabled;
+}
+
+void updateDisplayContrast(void)
+{
+}
+
+void refreshDisplay(void)
+{
+    mr_framebuffer_refresh_display(&mr);
+}
+
+// Display backlight
+
+void setBacklight(bool value)
+{
+}
+
+// Vibrator
+
+void initVibrator(void)
+{
+}
+
+void setVibrator(bool value)
+{
+}
+
+// LED
+
+void initPulseLED(void)
+{
+}
+
+void setPulseLED(bool value)
+{
+}
+
+void initAlertLED(void)
+{
+}
+
+void setAlertLED(bool value)
+{
+}
+
+void initPulseLEDEnable(void)
+{
+}
+
+void setPulseLEDEnable(bool value)
+{
+}
+
+void initAlertLEDEnable(void)
+{
+}
+
+void setAlertLEDEnable(bool value)
+{
+}
+
+#endif
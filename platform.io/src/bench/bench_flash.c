@@ -0,0 +1,60 @@
+/*
+ * Rad Pro
+ * Headless benchmark flash
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(BENCHMARK)
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../peripherals/flash.h"
+
+// RAM-only flash image: the benchmark must not touch the filesystem
+
+uint8_t flashImage[FLASH_SIZE_];
+
+void initFlash(void)
+{
+    memset(flashImage, 0xff, sizeof(flashImage));
+}
+
+bool verifyFlash(void)
+{
+    return true;
+}
+
+const uint8_t *readFlash(uint32_t source, uint32_t count)
+{
+    return flashImage + source;
+}
+
+bool writeFlash(uint32_t dest, const uint8_t *source, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        if (flashImage[dest + i] != 0xff)
+        {
+            printf("writeFlash: writing to non-erased memory: 0x%08x\n", dest);
+
+            return false;
+        }
+
+    memcpy(flashImage + dest, source, count);
+
+    return true;
+}
+
+bool eraseFlash(uint32_t dest)
+{
+    dest &= ~(FLASH_PAGE_SIZE - 1);
+
+    memset(flashImage + dest, 0xff, FLASH_PAGE_SIZE);
+
+    return true;
+}
+
+#endif
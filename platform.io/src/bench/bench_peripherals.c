@@ -0,0 +1,275 @@
+/*
+ * Rad Pro
+ * Headless benchmark peripherals
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(BENCHMARK)
+
+#include <string.h>
+
+#include "../peripherals/adc.h"
+#include "../peripherals/buzzer.h"
+#include "../peripherals/comm.h"
+#include "../peripherals/keyboard.h"
+#include "../peripherals/pulsesoundenable.h"
+#include "../peripherals/rtc.h"
+#include "../peripherals/voice.h"
+#include "../system/cstring.h"
+#include "../system/events.h"
+#include "../system/power.h"
+#include "../system/system.h"
+
+// 2026-01-01 00:00:00 UTC
+#define BENCH_START_TIME 1767225600
+
+// ADC
+
+void initADC(void)
+{
+}
+
+void onADCTick(uint32_t index)
+{
+}
+
+float readBatteryVoltage(void)
+{
+    return 3.854F;
+}
+
+float readElectricFieldStrength(void)
+{
+    return 76.0F;
+}
+
+float readMagneticFieldStrength(void)
+{
+    return 0.25E-6F;
+}
+
+// Buzzer
+
+#if defined(BUZZER)
+
+void initBuzzer(void)
+{
+}
+
+void onBuzzerTick(void)
+{
+}
+
+void setBuzzerVolume(uint8_t volume)
+{
+}
+
+void setBuzzer(bool value)
+{
+}
+
+#endif
+
+// Pulse sound enable
+
+#if defined(PULSESOUND_ENABLE)
+
+void initPulseSoundEnable(void)
+{
+}
+
+void setPulseSoundEnable(bool value)
+{
+}
+
+#endif
+
+// Voice
+
+#if defined(VOICE)
+
+void initVoice(void)
+{
+}
+
+void onVoiceTick(void)
+{
+}
+
+void playVoiceInstantaneousRate(void)
+{
+}
+
+void playVoiceAverageRate(void)
+{
+}
+
+void playVoiceCumulativeDose(void)
+{
+}
+
+void playVoiceTest(void)
+{
+}
+
+void playNumber(uint32_t value)
+{
+}
+
+void triggerVoiceAlert(void)
+{
+}
+
+void clearVoiceAlert(void)
+{
+}
+
+void stopVoice(void)
+{
+}
+
+#endif
+
+// Keyboard
+
+void initKeyboardHardware(void)
+{
+}
+
+void onKeyboardTick(void)
+{
+}
+
+void updateKeyboardState(void)
+{
+}
+
+// Comm
+
+const char *const commId = "Rad Pro benchmark;Rad Pro " FIRMWARE_VERSION "/" LANGUAGE;
+
+void initCommHardware(void)
+{
+}
+
+void openComm(void)
+{
+    clearComm(true);
+}
+
+void closeComm(void)
+{
+    clearComm(false);
+}
+
+void transmitComm(void)
+{
+    strclr(comm.buffer);
+    comm.bufferIndex = 0;
+
+    if (comm.transmitState == TRANSMIT_RESPONSE)
+        comm.state = COMM_RX;
+    else
+        comm.state = COMM_TX_READY;
+}
+
+void pollComm(void)
+{
+}
+
+// RTC, advanced by simulated ticks so runs are faster than real time
+
+static int32_t timeDelta;
+
+void initRTC(void)
+{
+}
+
+static uint32_t getLocalTime(void)
+{
+    return BENCH_START_TIME + currentTick / SYSTICK_FREQUENCY;
+}
+
+bool setDeviceTime(uint32_t value)
+{
+    timeDelta = value - getLocalTime();
+
+    return true;
+}
+
+uint32_t getDeviceTime(void)
+{
+    return getLocalTime() + timeDelta;
+}
+
+uint32_t getDeviceTimeFast(void)
+{
+    return getDeviceTime();
+}
+
+// Events
+
+void initEvents(void)
+{
+}
+
+void reloadWatchdog(void)
+{
+}
+
+void sleep(uint32_t value)
+{
+}
+
+// Power
+
+void initPower(bool value)
+{
+}
+
+void setPowerEnabled(bool value)
+{
+}
+
+bool isUSBPowered(void)
+{
+    return true;
+}
+
+bool isBatteryCharging(void)
+{
+    return true;
+}
+
+bool wasResetByWatchdog(void)
+{
+    return false;
+}
+
+void clearResetFlags(void)
+{
+}
+
+// System
+
+void initGPIO(void)
+{
+}
+
+void initSystem(void)
+{
+}
+
+void getDeviceId(char *s)
+{
+    strcpy(s, "b5706d937087f975b5812810");
+}
+
+void startBootloader(void)
+{
+}
+
+#endif
@@ -0,0 +1,386 @@
+/*
+ * Rad Pro
+ * Headless renderer benchmark
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(RENDER_BENCHMARK)
+
+#include <stdio.h>
+#include <string.h>
+
+#include <mcu-renderer-framebuffer.h>
+
+#include "../bench/bench.h"
+#include "../measurements/average.h"
+#include "../measurements/cumulative.h"
+#include "../measurements/history.h"
+#include "../measurements/instantaneous.h"
+#include "../peripherals/display.h"
+#include "../peripherals/tube.h"
+#include "../system/events.h"
+#include "../system/settings.h"
+#include "../system/statistics.h"
+#include "../ui/draw.h"
+#include "../ui/view.h"
+
+// Fonts are renamed, so all variants can be linked side by side
+
+#include "../bench/bench_render_fonts.h"
+
+#define font_large benchFontLargeColor115
+#include "../ui/fonts/font_large_color_115.h"
+#undef font_large
+#include "../bench/bench_render_fonts.h"
+
+#define font_large benchFontLargeColor115_2bpp
+#include "../ui/fonts/font_large_color_115_2bpp.h"
+#undef font_large
+#include "../bench/bench_render_fonts.h"
+
+#define font_large benchFontLargeColor115_1bpp
+#include "../ui/fonts/font_large_color_115_1bpp.h"
+#undef font_large
+#include "../bench/bench_render_fonts.h"
+
+#define font_large benchFontLargeColor84
+#include "../ui/fonts/font_large_color_84.h"
+#undef font_large
+#include "../bench/bench_render_fonts.h"
+
+#define font_large benchFontLargeMonochrome
+#include "../ui/fonts/font_large_monochrome.h"
+#undef font_large
+#include "../bench/bench_render_fonts.h"
+
+#define font_medium benchFontMediumColor32
+#include "../ui/fonts/font_medium_en_color_32.h"
+#undef font_medium
+#include "../bench/bench_render_fonts.h"
+
+#define font_medium benchFontMediumColor32_2bpp
+#include "../ui/fonts/font_medium_en_color_32_2bpp.h"
+#undef font_medium
+#include "../bench/bench_render_fonts.h"
+
+#define font_medium benchFontMediumColor24
+#include "../ui/fonts/font_medium_en_color_24.h"
+#undef font_medium
+#include "../bench/bench_render_fonts.h"
+
+#define font_medium benchFontMediumMonochrome
+#include "../ui/fonts/font_medium_en_monochrome.h"
+#undef font_medium
+#include "../bench/bench_render_fonts.h"
+
+#define BENCH_RENDER_CASE_TIME_DEFAULT 200
+#define BENCH_RENDER_WARMUP_TIME (10 * 60)
+
+#define BENCH_RENDER_BLOCK_WIDTH 64
+#define BENCH_RENDER_BLOCK_HEIGHT 64
+
+#define BENCH_RENDER_LARGE_TEXT "0123.456789"
+#define BENCH_RENDER_MEDIUM_TEXT "cpm/\xc2\xb5Sv/h/mSv"
+
+typedef struct
+{
+    const char *name;
+    const uint8_t *font;
+    const char *text;
+} BenchRenderFont;
+
+typedef struct
+{
+    const char *name;
+    OnViewEvent *onViewEvent;
+    ShowView *showView;
+} BenchRenderScreen;
+
+static const BenchRenderFont benchRenderFonts[] = {
+    {"large_color_115", benchFontLargeColor115, BENCH_RENDER_LARGE_TEXT},
+    {"large_color_115_2bpp", benchFontLargeColor115_2bpp, BENCH_RENDER_LARGE_TEXT},
+    {"large_color_115_1bpp", benchFontLargeColor115_1bpp, BENCH_RENDER_LARGE_TEXT},
+    {"large_color_84", benchFontLargeColor84, BENCH_RENDER_LARGE_TEXT},
+    {"large_monochrome", benchFontLargeMonochrome, BENCH_RENDER_LARGE_TEXT},
+    {"medium_color_32", benchFontMediumColor32, BENCH_RENDER_MEDIUM_TEXT},
+    {"medium_color_32_2bpp", benchFontMediumColor32_2bpp, BENCH_RENDER_MEDIUM_TEXT},
+    {"medium_color_24", benchFontMediumColor24, BENCH_RENDER_MEDIUM_TEXT},
+    {"medium_monochrome", benchFontMediumMonochrome, BENCH_RENDER_MEDIUM_TEXT},
+};
+
+static const BenchRenderScreen benchRenderScreens[] = {
+    {"instantaneous", onInstantaneousRateViewEvent, NULL},
+    {"average", onAverageRateViewEvent, NULL},
+    {"cumulative", onCumulativeDoseViewEvent, NULL},
+    {"history", onHistoryViewEvent, NULL},
+    {"settings menu", NULL, showSettingsMenu},
+    {"tube menu", NULL, showTubeMenu},
+    {"statistics", NULL, showStatisticsView},
+};
+
+extern mr_t mr;
+
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+static uint8_t benchRenderGlyphCache[GLYPH_CACHE_SIZE];
+#endif
+
+static struct
+{
+    uint64_t caseTime;
+
+    uint64_t startTime;
+    uint32_t iterationNum;
+} benchRender;
+
+// Measurement loop
+
+static void startBenchRenderCase(void)
+{
+    mr_framebuffer_reset_stats(&mr);
+
+    benchRender.iterationNum = 0;
+    benchRender.startTime = getBenchTime();
+}
+
+static bool isBenchRenderCaseRunning(void)
+{
+    if (benchRender.iterationNum &&
+        ((getBenchTime() - benchRender.startTime) >= benchRender.caseTime))
+        return false;
+
+    benchRender.iterationNum++;
+
+    return true;
+}
+
+static void printBenchRenderCase(const char *name, uint32_t glyphNum)
+{
+    double elapsedTime = (getBenchTime() - benchRender.startTime) * 1E-9;
+    double iterationNum = benchRender.iterationNum;
+
+    const mr_framebuffer_stats_t *stats = mr_framebuffer_get_stats(&mr);
+
+    printf("%-36s %12.1f us/call %10.2f Mpixels/s",
+           name,
+           elapsedTime * 1E6 / iterationNum,
+           stats->pixel_count * 1E-6 / elapsedTime);
+
+    if (glyphNum)
+        printf(" %10.0f glyphs/s", glyphNum * iterationNum / elapsedTime);
+    else
+        printf(" %17s", "");
+
+    printf(" %10.0f bytes/call\n", stats->sent_bytes / iterationNum);
+}
+
+// Primitives
+
+static void benchRenderRectangles(void)
+{
+    mr_rectangle_t rectangle = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+
+    startBenchRenderCase();
+    while (isBenchRenderCaseRunning())
+    {
+        mr_set_fill_color(&mr, benchRender.iterationNum);
+        mr_draw_rectangle(&mr, &rectangle);
+    }
+    printBenchRenderCase("rectangle", 0);
+}
+
+static uint32_t getUTF8CharNum(const char *text)
+{
+    uint32_t charNum = 0;
+
+    for (; *text; text++)
+        if ((*text & 0xc0) != 0x80)
+            charNum++;
+
+    return charNum;
+}
+
+static uint32_t getBenchRenderFrameHash(void)
+{
+    // FNV-1a
+    const uint8_t *p = (const uint8_t *)mr.buffer;
+    uint32_t hash = 0x811c9dc5;
+
+    for (uint32_t i = 0; i < mr.buffer_size; i++)
+        hash = (hash ^ p[i]) * 0x01000193;
+
+    return hash;
+}
+
+static void benchRenderFont(const BenchRenderFont *benchFont,
+                            const char *name)
+{
+    mr_set_font(&mr, benchFont->font);
+
+    int16_t textWidth = mr_get_utf8_text_width(&mr, (const uint8_t *)benchFont->text);
+    mr_rectangle_t rectangle = {
+        0,
+        0,
+        (textWidth < DISPLAY_WIDTH) ? textWidth : DISPLAY_WIDTH,
+        mr_get_line_height(&mr),
+    };
+    if (rectangle.height > DISPLAY_HEIGHT)
+        rectangle.height = DISPLAY_HEIGHT;
+    mr_point_t offset = {0, 0};
+
+    mr_set_fill_color(&mr, 0x0000);
+    mr_set_stroke_color(&mr, 0xffff);
+
+    memset(mr.buffer, 0, mr.buffer_size);
+
+    startBenchRenderCase();
+    while (isBenchRenderCaseRunning())
+        mr_draw_utf8_text(&mr,
+                          (const uint8_t *)benchFont->text,
+                          &rectangle,
+                          &offset);
+    printBenchRenderCase(name,
+                         getUTF8CharNum(benchFont->text));
+}
+
+static void benchRenderText(void)
+{
+    for (uint32_t i = 0; i < (sizeof(benchRenderFonts) / sizeof(BenchRenderFont)); i++)
+    {
+        const BenchRenderFont *benchFont = &benchRenderFonts[i];
+
+        benchRenderFont(benchFont, benchFont->name);
+
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+        // Cached glyphs must draw the same pixels as decoded ones
+        uint32_t frameHash = getBenchRenderFrameHash();
+
+        mr_set_glyph_cache(&mr,
+                           benchFont->font,
+                           benchRenderGlyphCache,
+                           sizeof(benchRenderGlyphCache));
+
+        char name[40];
+        snprintf(name, sizeof(name), "%s (glyph cache)", benchFont->name);
+
+        benchRenderFont(benchFont, name);
+
+        if (getBenchRenderFrameHash() != frameHash)
+            printf("%-36s output differs from uncached glyphs\n", name);
+#endif
+    }
+
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+    initDraw();
+#endif
+}
+
+#if defined(MCURENDERER_BITMAP_SUPPORT)
+static void benchRenderBitmap(void)
+{
+    static uint8_t bitmap[BENCH_RENDER_BLOCK_WIDTH * BENCH_RENDER_BLOCK_HEIGHT / 8];
+
+    for (uint32_t i = 0; i < sizeof(bitmap); i++)
+        bitmap[i] = (i & 0b1) ? 0x55 : 0xaa;
+
+    mr_rectangle_t rectangle = {0, 0, BENCH_RENDER_BLOCK_WIDTH, BENCH_RENDER_BLOCK_HEIGHT};
+
+    startBenchRenderCase();
+    while (isBenchRenderCaseRunning())
+        mr_draw_bitmap(&mr, &rectangle, bitmap);
+    printBenchRenderCase("bitmap", 0);
+}
+#endif
+
+#if defined(MCURENDERER_IMAGE_SUPPORT)
+static void benchRenderImage(void)
+{
+    static mr_color_t image[BENCH_RENDER_BLOCK_WIDTH * BENCH_RENDER_BLOCK_HEIGHT];
+
+    for (uint32_t i = 0; i < (BENCH_RENDER_BLOCK_WIDTH * BENCH_RENDER_BLOCK_HEIGHT); i++)
+        image[i] = i * 0x0821;
+
+    mr_rectangle_t rectangle = {0, 0, BENCH_RENDER_BLOCK_WIDTH, BENCH_RENDER_BLOCK_HEIGHT};
+
+    startBenchRenderCase();
+    while (isBenchRenderCaseRunning())
+        mr_draw_image(&mr, &rectangle, image);
+    printBenchRenderCase("image", 0);
+}
+#endif
+
+// Screens
+
+static void benchRenderScreen(const BenchRenderScreen *screen, bool cached)
+{
+    if (screen->onViewEvent)
+        showView(screen->onViewEvent);
+    else
+        screen->showView();
+
+    // Cached frames (color displays) start from an already drawn screen
+    drawView();
+    refreshDisplay();
+
+    startBenchRenderCase();
+    while (isBenchRenderCaseRunning())
+    {
+        if (!cached)
+            invalidateDrawCache();
+
+        drawView();
+        refreshDisplay();
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "%s%s", screen->name, cached ? " (cached)" : "");
+
+    printBenchRenderCase(name, 0);
+}
+
+// Benchmark
+
+void runRenderBenchmark(void)
+{
+    benchRender.caseTime = getBenchEnvironmentValue("RADPRO_BENCH_CASE_TIME",
+                                                    BENCH_RENDER_CASE_TIME_DEFAULT) *
+                           1000000ULL;
+
+    printf("Display: %ux%u %s\n",
+           DISPLAY_WIDTH,
+           DISPLAY_HEIGHT,
+#if defined(DISPLAY_MONOCHROME)
+           "monochrome"
+#else
+           "color"
+#endif
+    );
+
+    printf("\nPrimitives\n");
+    benchRenderRectangles();
+#if defined(MCURENDERER_BITMAP_SUPPORT)
+    benchRenderBitmap();
+#endif
+#if defined(MCURENDERER_IMAGE_SUPPORT)
+    benchRenderImage();
+#endif
+
+    printf("\nText\n");
+    benchRenderText();
+
+    // Fill the 10-minute history before drawing the screens
+    simulateBenchTicks(BENCH_RENDER_WARMUP_TIME * SYSTICK_FREQUENCY);
+
+    printf("\nScreens\n");
+    for (uint32_t i = 0; i < (sizeof(benchRenderScreens) / sizeof(BenchRenderScreen)); i++)
+    {
+        benchRenderScreen(&benchRenderScreens[i], false);
+#if defined(DISPLAY_COLOR)
+        benchRenderScreen(&benchRenderScreens[i], true);
+#endif
+    }
+}
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * Rad Pro
+ * Headless renderer benchmark font macros
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+// Included after each benchmark font, without include guard
+
+#undef FONT_LARGE_SIZE
+#undef FONT_LARGE_ASCENT
+#undef FONT_LARGE_DESCENT
+#undef FONT_LARGE_CAP_HEIGHT
+#undef FONT_LARGE_LINE_HEIGHT
+#undef FONT_LARGE_BOUNDINGBOX_LEFT
+#undef FONT_LARGE_BOUNDINGBOX_BOTTOM
+#undef FONT_LARGE_BOUNDINGBOX_WIDTH
+#undef FONT_LARGE_BOUNDINGBOX_HEIGHT
+
+#undef FONT_MEDIUM_SIZE
+#undef FONT_MEDIUM_ASCENT
+#undef FONT_MEDIUM_DESCENT
+#undef FONT_MEDIUM_CAP_HEIGHT
+#undef FONT_MEDIUM_LINE_HEIGHT
+#undef FONT_MEDIUM_BOUNDINGBOX_LEFT
+#undef FONT_MEDIUM_BOUNDINGBOX_BOTTOM
+#undef FONT_MEDIUM_BOUNDINGBOX_WIDTH
+#undef FONT_MEDIUM_BOUNDINGBOX_HEIGHT
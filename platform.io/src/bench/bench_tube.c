@@ -0,0 +1,53 @@
+/*
+ * Rad Pro
+ * Headless benchmark tube
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(BENCHMARK)
+
+#include <stdlib.h>
+
+#include "../peripherals/tube.h"
+#include "../sdl/sdlsim_pulsetrain.h"
+#include "../system/events.h"
+
+#define BENCH_TUBE_CPS_DEFAULT 100.0F
+#define BENCH_TUBE_SEED 0x2545f491
+
+void initTubeHardware(void)
+{
+    const char *cpsValue = getenv("RADPRO_BENCH_CPS");
+    float cps = cpsValue ? strtof(cpsValue, NULL) : BENCH_TUBE_CPS_DEFAULT;
+    if (cps <= 0)
+        cps = BENCH_TUBE_CPS_DEFAULT;
+
+    // Seeded, so that runs are reproducible
+    initPulseTrain(BENCH_TUBE_SEED);
+    setPulseTrainRate(cps);
+
+    tubeDeadTime = (uint32_t)(0.000075F * PULSE_MEASUREMENT_FREQUENCY);
+}
+
+void setTubeHVEnabled(bool value)
+{
+}
+
+void updateTubeHV(void)
+{
+}
+
+void onTubeTick(void)
+{
+    onPulseTrainTick();
+}
+
+bool readTubeDet(void)
+{
+    return false;
+}
+
+#endif
@@ -364,9 +364,11 @@ static const char *onGameStrengthMenuGetOption(menu_size_t index, MenuStyle *men
 {
     *menuStyle = (index == settings.gameStrength);
 
-    strcpy(menuOption, getString(STRING_GAME_LEVEL));
-    strcatChar(menuOption, ' ');
-    strcatUInt32(menuOption, index + 1, 0);
+    StrBuf optionBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    strbufString(&optionBuffer, getString(STRING_GAME_LEVEL));
+    strbufChar(&optionBuffer, ' ');
+    strbufUInt32(&optionBuffer, index + 1, 0);
 
     return menuOption;
 }
@@ -11,6 +11,7 @@
 #include <emscripten.h>
 #endif
 
+#include "bench/bench.h"
 #include "extras/game.h"
 #include "measurements/datalog.h"
 #include "peripherals/adc.h"
@@ -27,9 +28,10 @@
 #include "system/power.h"
 #include "system/settings.h"
 #include "system/system.h"
+#include "ui/draw.h"
 #include "ui/view.h"
 
-#if defined(SIMULATOR)
+#if defined(SIMULATOR) && !defined(BENCHMARK)
 bool onSDLTick();
 
 static void simulateFrame(void)
@@ -62,6 +64,7 @@ int main(void)
     initComm();
     initKeyboard();
     initDisplay();
+    initDraw();
     initView();
 #if defined(SOUND)
     initSound();
@@ -77,7 +80,11 @@ int main(void)
 
     // Main loop
 #if defined(SIMULATOR)
-#if defined(__EMSCRIPTEN__)
+#if defined(RENDER_BENCHMARK)
+    runRenderBenchmark();
+#elif defined(BENCHMARK)
+    runBenchmark();
+#elif defined(__EMSCRIPTEN__)
     emscripten_set_main_loop(simulateFrame, 0, 1);
 #else
     while (true)
@@ -206,9 +206,13 @@ static MeasurementStyle getAverageRateMeasurementStyle(void)
 
 static void drawAverageRateValue(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = "";
-    buildValueString(valueString, unitString, average.snapshotRate.value, &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    buildValueString(&valueBuffer, &unitBuffer, average.snapshotRate.value, &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
 
     drawTitleBar(getString(STRING_AVERAGE));
     drawMeasurementValue(valueString, unitString, average.snapshotRate.confidence, getAverageRateMeasurementStyle());
@@ -216,28 +220,33 @@ static void drawAverageRateValue(void)
 
 static void drawAverageRateTab(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = " ";
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
     const char *keyString = NULL;
 
     switch (averageTab)
     {
     case AVERAGE_TAB_TIME:
-        strcatTime(valueString, average.snapshotRate.time);
+        strbufTime(&valueBuffer, average.snapshotRate.time);
 
         keyString = getString(STRING_TIME);
 
         break;
 
     case AVERAGE_TAB_RATE:
-        buildValueString(valueString, unitString, average.snapshotRate.value, &pulseUnits[settings.secondaryDoseUnits].rate, doseUnitsMinMetricPrefix[settings.secondaryDoseUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, average.snapshotRate.value, &pulseUnits[settings.secondaryDoseUnits].rate, doseUnitsMinMetricPrefix[settings.secondaryDoseUnits]);
 
         keyString = getString(STRING_RATE);
 
         break;
 
     case AVERAGE_TAB_DOSE:
-        buildValueString(valueString, unitString, average.snapshotPulseCount, &pulseUnits[DOSE_UNITS_CPM].dose, doseUnitsMinMetricPrefix[DOSE_UNITS_CPM]);
+        buildValueString(&valueBuffer, &unitBuffer, average.snapshotPulseCount, &pulseUnits[DOSE_UNITS_CPM].dose, doseUnitsMinMetricPrefix[DOSE_UNITS_CPM]);
 
         keyString = getString(STRING_DOSE);
 
@@ -161,9 +161,13 @@ static MeasurementStyle getCumulativeDoseMeasurementStyle(void)
 
 static void drawCumulativeDoseValue(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = "";
-    buildValueString(valueString, unitString, cumulative.dose.pulseCount, &pulseUnits[settings.doseUnits].dose, doseUnitsMinMetricPrefix[settings.doseUnits]);
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    buildValueString(&valueBuffer, &unitBuffer, cumulative.dose.pulseCount, &pulseUnits[settings.doseUnits].dose, doseUnitsMinMetricPrefix[settings.doseUnits]);
 
     drawTitleBar(getString(STRING_CUMULATIVE));
     drawMeasurementValue(valueString, unitString, 0, getCumulativeDoseMeasurementStyle());
@@ -171,28 +175,33 @@ static void drawCumulativeDoseValue(void)
 
 static void drawCumulativeDoseTab(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = " ";
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
     const char *keyString = NULL;
 
     switch (cumulativeTab)
     {
     case CUMULATIVE_TAB_TIME:
-        strcatTime(valueString, cumulative.dose.time);
+        strbufTime(&valueBuffer, cumulative.dose.time);
 
         keyString = getString(STRING_TIME);
 
         break;
 
     case CUMULATIVE_TAB_DOSE:
-        buildValueString(valueString, unitString, cumulative.dose.pulseCount, &pulseUnits[settings.secondaryDoseUnits].dose, doseUnitsMinMetricPrefix[settings.secondaryDoseUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, cumulative.dose.pulseCount, &pulseUnits[settings.secondaryDoseUnits].dose, doseUnitsMinMetricPrefix[settings.secondaryDoseUnits]);
 
         keyString = getString(STRING_DOSE);
 
         break;
 
     case CUMULATIVE_TAB_INSTANTANEOUS:
-        buildValueString(valueString, unitString, getInstantaneousRate(), &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, getInstantaneousRate(), &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
 
         keyString = getString(STRING_INSTANTANEOUS);
 
@@ -12,6 +12,7 @@
 #include "../peripherals/flash.h"
 #include "../peripherals/rtc.h"
 #include "../system/cmath.h"
+#include "../system/events.h"
 #include "../system/settings.h"
 #include "../ui/menu.h"
 #include "../ui/system.h"
@@ -21,17 +22,35 @@
 #define DATALOG_PAGE_STATE_OFFSET (DATALOG_PAGE_SIZE - DATALOG_PAGE_STATE_SIZE)
 #define DATALOG_PAGE_STATE_SIZE FLASH_WORD_SIZE
 
-#define DATALOG_BUFFER_SIZE 16
+#define DATALOG_BUFFER_SIZE (DATALOG_BURST_ENTRY_SIZE_MAX + 2 * FLASH_WORD_SIZE)
 
+#define DATALOG_PAGE_START_SCAN_SIZE 32
+
+#define DATALOG_ENTRY_DELTAOFDELTA_RUN 0x60
 #define DATALOG_ENTRY_INCREMENTAL_2BYTES 0x80
 #define DATALOG_ENTRY_INCREMENTAL_3BYTES 0xc0
 #define DATALOG_ENTRY_INCREMENTAL_4BYTES 0xe0
 #define DATALOG_ENTRY_INCREMENTAL_5BYTES 0xf0
 #define DATALOG_ENTRY_ABSOLUTE 0xf1
+#define DATALOG_ENTRY_BURST_8BIT 0xf6
+#define DATALOG_ENTRY_BURST_16BIT 0xf7
 #define DATALOG_ENTRY_SESSION_START 0xf8
+#define DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA 0xf9
 #define DATALOG_ENTRY_FILLER 0xfe
 #define DATALOG_ENTRY_EMPTY 0xff
 
+#define DATALOG_RUN_LENGTH_MIN 2
+#define DATALOG_RUN_LENGTH_MAX (DATALOG_RUN_LENGTH_MIN + (DATALOG_ENTRY_INCREMENTAL_2BYTES - DATALOG_ENTRY_DELTAOFDELTA_RUN) - 1)
+#define DATALOG_RUN_TIME_MAX 60
+
+// Burst blocks hold one second of samples
+#if !defined(DATALOG_BURST_SAMPLE_TICKS)
+#define DATALOG_BURST_SAMPLE_TICKS (SYSTICK_FREQUENCY / 10)
+#endif
+#define DATALOG_BURST_SAMPLE_NUM (SYSTICK_FREQUENCY / DATALOG_BURST_SAMPLE_TICKS)
+#define DATALOG_BURST_BLOCK_NUM 4
+#define DATALOG_BURST_ENTRY_SIZE_MAX (2 + 2 * DATALOG_BURST_SAMPLE_NUM)
+
 typedef enum
 {
     PAGESTATE_FULL = 0x00,
@@ -48,11 +67,18 @@ typedef struct
 
     uint32_t pageBase;
     uint32_t pageOffset;
+    uint32_t entryOffset;
 
     Dose dose;
 
     uint8_t buffer[DATALOG_BUFFER_SIZE];
     size_t bufferLength;
+
+    uint32_t delta;
+    uint32_t runLength;
+
+    bool markerValid;
+    DatalogMarker marker;
 } DatalogWrite;
 
 typedef struct
@@ -64,14 +90,34 @@ typedef struct
     const uint8_t *page;
 
     uint32_t timeInterval;
+
+    bool deltaOfDelta;
+    uint32_t delta;
+    uint32_t runCount;
 } DatalogRead;
 
+typedef struct
+{
+    bool enabled;
+
+    // onDatalogTick
+    volatile uint32_t blockNum;
+    uint32_t sampleTick;
+    uint32_t sampleIndex;
+    uint32_t previousPulseCount;
+
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    uint16_t samples[DATALOG_BURST_BLOCK_NUM][DATALOG_BURST_SAMPLE_NUM];
+} DatalogBurst;
+
 static struct
 {
     uint32_t previousTimeFast;
 
     DatalogWrite write;
     DatalogRead read;
+    DatalogBurst burst;
 } datalog;
 
 static const uint16_t loggingModeIntervals[] = {
@@ -83,8 +129,6 @@ static const uint16_t loggingModeIntervals[] = {
     1,
 };
 
-static void stopDatalogRead(void);
-
 void resetDatalog(void)
 {
     selectMenuItem(&datalogMenu, 0);
@@ -93,19 +137,6 @@ void resetDatalog(void)
 
 // Page management
 
-static bool isFlashEmpty(uint32_t address, uint32_t count)
-{
-    const uint8_t *p = readFlash(address, count);
-
-    for (uint32_t i = 0; i < count; i++)
-    {
-        if (p[i] != 0xff)
-            return false;
-    }
-
-    return true;
-}
-
 static uint32_t alignAddressToFlashWordSize(uint32_t value)
 {
     return (value + FLASH_WORD_SIZE - 1) & ~(FLASH_WORD_SIZE - 1);
@@ -258,6 +289,60 @@ static uint32_t decodeVariableUInt32(const uint8_t *p, uint32_t *value)
     return 0;
 }
 
+// Delta-of-delta encoder/decoder
+
+static uint32_t encodeDeltaOfDelta(uint8_t *p, uint32_t delta, uint32_t previousDelta)
+{
+    // Zig-zag code, so that small negative differences stay small
+    int32_t deltaOfDelta = (int32_t)(delta - previousDelta);
+    uint32_t value = ((uint32_t)deltaOfDelta << 1) ^ (uint32_t)(deltaOfDelta >> 31);
+
+    if (value < DATALOG_ENTRY_DELTAOFDELTA_RUN)
+    {
+        p[0] = value;
+
+        return 1;
+    }
+    else if (value < DATALOG_ENTRY_INCREMENTAL_2BYTES)
+    {
+        // 1-byte values collide with run entries
+        p[0] = DATALOG_ENTRY_INCREMENTAL_2BYTES;
+        p[1] = value;
+
+        return 2;
+    }
+    else
+        return encodeVariableUInt32(p, value);
+}
+
+static uint32_t decodeDeltaOfDelta(uint32_t value, uint32_t previousDelta)
+{
+    return previousDelta + ((value >> 1) ^ -(value & 1));
+}
+
+// Absolute entries
+
+static bool isAbsoluteEntry(uint8_t c)
+{
+    return ((c >= DATALOG_ENTRY_ABSOLUTE) &&
+            (c < (DATALOG_ENTRY_ABSOLUTE + (DATALOG_LOGGINGMODE_NUM - 1)))) ||
+           ((c >= DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA) &&
+            (c < (DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA + (DATALOG_LOGGINGMODE_NUM - 1))));
+}
+
+static bool isDeltaOfDeltaAbsoluteEntry(uint8_t c)
+{
+    return c >= DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA;
+}
+
+static uint32_t getAbsoluteEntryLoggingMode(uint8_t c)
+{
+    if (isDeltaOfDeltaAbsoluteEntry(c))
+        return (c - DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA) + 1;
+    else
+        return (c - DATALOG_ENTRY_ABSOLUTE) + 1;
+}
+
 // Datalog write
 
 static void writePageStateAndAdvance(PageState pageState)
@@ -277,12 +362,13 @@ static void writePageStateAndAdvance(PageState pageState)
     }
     else
     {
-        // Advance to next page
+        // Advance to next page, erasing it if not done in the background
         datalog.write.pageBase = getNextPage(datalog.write.pageBase);
 
-        // Erase
-        if (!isFlashEmpty(datalog.write.pageBase, DATALOG_PAGE_SIZE))
-            eraseFlash(datalog.write.pageBase);
+        completeFlashErase(datalog.write.pageBase);
+
+        // Pre-erase the page after it
+        requestFlashErase(getNextPage(datalog.write.pageBase));
     }
 }
 
@@ -297,13 +383,19 @@ static void flushDatalogBuffer(void)
     datalog.write.bufferLength = 0;
 }
 
+static bool hasDatalogPageSpace(uint32_t count)
+{
+    return (datalog.write.pageOffset + datalog.write.bufferLength + count) <= DATALOG_PAGE_STATE_OFFSET;
+}
+
 static bool appendDatalogEntryToCurrentPage(const uint8_t *entry, uint32_t count)
 {
     // Fail if entry does not fit within page
-    if ((datalog.write.pageOffset + datalog.write.bufferLength + count) > DATALOG_PAGE_STATE_OFFSET)
+    if (!hasDatalogPageSpace(count))
         return false;
 
     // Append
+    datalog.write.entryOffset = datalog.write.pageOffset + datalog.write.bufferLength;
     memcpy(datalog.write.buffer + datalog.write.bufferLength, entry, count);
     datalog.write.bufferLength += count;
 
@@ -319,31 +411,76 @@ static bool appendDatalogEntryWithPageRollover(const uint8_t *entry, uint32_t co
     if (appendDatalogEntryToCurrentPage(entry, count))
         return true;
 
+    // Keep pending bytes on the page they belong to
+    flushDatalogBuffer();
     writePageStateAndAdvance(PAGESTATE_FULL);
 
     return appendDatalogEntryToCurrentPage(entry, count);
 }
 
+static void flushDatalogRun(void)
+{
+    if (!datalog.write.runLength)
+        return;
+
+    uint8_t entry[1];
+    if (datalog.write.runLength < DATALOG_RUN_LENGTH_MIN)
+        entry[0] = 0;
+    else
+        entry[0] = DATALOG_ENTRY_DELTAOFDELTA_RUN + (datalog.write.runLength - DATALOG_RUN_LENGTH_MIN);
+
+    // Space was reserved when the run started
+    appendDatalogEntryToCurrentPage(entry, sizeof(entry));
+
+    datalog.write.runLength = 0;
+}
+
 static void writeDatalogSessionStart(void)
 {
     const uint8_t sessionStartEntry[] = {DATALOG_ENTRY_SESSION_START};
 
+    flushDatalogRun();
+
     appendDatalogEntryWithPageRollover(sessionStartEntry, sizeof(sessionStartEntry));
 }
 
-static void appendDatalogAbsoluteEntry(void)
+static void stopDatalogBurst(void)
 {
-    datalog.write.dose.time = getDeviceTime();
-    datalog.write.dose.pulseCount = getTubePulseCount();
+    datalog.burst.enabled = false;
+    datalog.burst.blockNum = 0;
+    datalog.burst.tail = datalog.burst.head;
+}
+
+static void writeDatalogAbsoluteEntry(void)
+{
+    flushDatalogRun();
+
+    datalog.write.delta = 0;
 
     uint8_t entry[9];
     uint8_t *p = entry;
 
-    *p++ = DATALOG_ENTRY_ABSOLUTE + (settings.loggingMode - 1);
+    *p++ = DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA + (settings.loggingMode - 1);
     p += encodeFixedUInt32(p, datalog.write.dose.time);
     p += encodeFixedUInt32(p, datalog.write.dose.pulseCount);
 
-    appendDatalogEntryWithPageRollover(entry, sizeof(entry));
+    if (appendDatalogEntryWithPageRollover(entry, sizeof(entry)))
+    {
+        datalog.write.markerValid = true;
+        datalog.write.marker.pageBase = datalog.write.pageBase;
+        datalog.write.marker.pageOffset = datalog.write.entryOffset;
+        datalog.write.marker.dose = datalog.write.dose;
+    }
+}
+
+static void appendDatalogAbsoluteEntry(void)
+{
+    stopDatalogBurst();
+
+    datalog.write.dose.time = getDeviceTime();
+    datalog.write.dose.pulseCount = getTubePulseCount();
+
+    writeDatalogAbsoluteEntry();
 
     stopDatalogRead();
 }
@@ -351,20 +488,94 @@ static void appendDatalogAbsoluteEntry(void)
 static bool appendDatalogIncrementalEntry(void)
 {
     uint32_t pulseCount = getTubePulseCount();
-    uint32_t value = pulseCount - datalog.write.dose.pulseCount;
+    uint32_t delta = pulseCount - datalog.write.dose.pulseCount;
+    uint32_t loggingInterval = loggingModeIntervals[settings.loggingMode];
 
-    uint8_t entry[5];
-    uint32_t count = encodeVariableUInt32(entry, value);
+    if ((delta == datalog.write.delta) &&
+        (datalog.write.runLength || hasDatalogPageSpace(1)))
+    {
+        // Repeated delta: extend run, written when it ends
+        datalog.write.runLength++;
 
-    if (!appendDatalogEntryToCurrentPage(entry, count))
-        return false;
+        if ((datalog.write.runLength >= DATALOG_RUN_LENGTH_MAX) ||
+            (((datalog.write.runLength + 1) * loggingInterval) > DATALOG_RUN_TIME_MAX))
+            flushDatalogRun();
+    }
+    else
+    {
+        flushDatalogRun();
+
+        uint8_t entry[5];
+        uint32_t count = encodeDeltaOfDelta(entry, delta, datalog.write.delta);
+
+        if (!appendDatalogEntryToCurrentPage(entry, count))
+            return false;
+
+        datalog.write.delta = delta;
+    }
 
     datalog.write.dose.pulseCount = pulseCount;
-    datalog.write.dose.time += loggingModeIntervals[settings.loggingMode];
+    datalog.write.dose.time += loggingInterval;
 
     return true;
 }
 
+static void appendDatalogBurstEntry(const uint16_t *samples)
+{
+    uint8_t entry[DATALOG_BURST_ENTRY_SIZE_MAX];
+    uint8_t *p = entry;
+
+    uint32_t sampleSum = 0;
+    bool wide = false;
+    for (uint32_t i = 0; i < DATALOG_BURST_SAMPLE_NUM; i++)
+    {
+        sampleSum += samples[i];
+        if (samples[i] > UINT8_MAX)
+            wide = true;
+    }
+
+    *p++ = wide ? DATALOG_ENTRY_BURST_16BIT : DATALOG_ENTRY_BURST_8BIT;
+    *p++ = DATALOG_BURST_SAMPLE_NUM;
+    for (uint32_t i = 0; i < DATALOG_BURST_SAMPLE_NUM; i++)
+    {
+        if (wide)
+            *p++ = samples[i] >> 8;
+        *p++ = samples[i] & 0xff;
+    }
+
+    uint32_t count = p - entry;
+    if (!appendDatalogEntryToCurrentPage(entry, count))
+    {
+        // Start the next page at the end of the previous block
+        flushDatalogBuffer();
+        writePageStateAndAdvance(PAGESTATE_FULL);
+        writeDatalogAbsoluteEntry();
+        appendDatalogEntryToCurrentPage(entry, count);
+    }
+
+    datalog.write.dose.time += 1;
+    datalog.write.dose.pulseCount += sampleSum;
+}
+
+static void updateDatalogBurst(void)
+{
+    // Read before draining, so that the last block is not missed
+    uint32_t blockNum = datalog.burst.blockNum;
+
+    while (datalog.burst.tail != datalog.burst.head)
+    {
+        uint32_t tail = datalog.burst.tail;
+
+        appendDatalogBurstEntry(datalog.burst.samples[tail % DATALOG_BURST_BLOCK_NUM]);
+
+        datalog.burst.tail = tail + 1;
+    }
+
+    // Resynchronize with the real-time clock
+    if (!blockNum)
+        appendDatalogAbsoluteEntry();
+}
+
 void startDatalog(void)
 {
     if (settings.loggingMode == DATALOG_LOGGINGMODE_OFF)
@@ -378,6 +589,9 @@ void startDatalog(void)
 
 void stopDatalog(void)
 {
+    if (!datalog.write.active)
+        return;
+
     appendDatalogAbsoluteEntry();
 
     datalog.write.active = false;
@@ -391,15 +605,94 @@ void writeDatalogTimeChange(void)
 
 void clearDatalog(void)
 {
+    datalog.write.runLength = 0;
+
     flushDatalogBuffer();
     writePageStateAndAdvance(PAGESTATE_RESET);
     clearHistory();
+    eraseSavedHistory();
+
+    datalog.write.markerValid = false;
+
+    // Delta-of-delta entries need a preceding absolute entry
+    if (datalog.write.active)
+        appendDatalogAbsoluteEntry();
 
     stopDatalogRead();
 }
 
+bool startDatalogBurst(uint32_t time)
+{
+    if (!datalog.write.active ||
+        datalog.read.active ||
+        !time ||
+        (time > DATALOG_BURST_TIME_MAX))
+        return false;
+
+    appendDatalogAbsoluteEntry();
+
+    syncTick();
+
+    datalog.burst.enabled = true;
+    datalog.burst.sampleTick = 0;
+    datalog.burst.sampleIndex = 0;
+    datalog.burst.previousPulseCount = datalog.write.dose.pulseCount;
+    datalog.burst.head = 0;
+    datalog.burst.tail = 0;
+    datalog.burst.blockNum = time;
+
+    return true;
+}
+
+void onDatalogTick(void)
+{
+    if (!datalog.burst.blockNum)
+        return;
+
+    datalog.burst.sampleTick++;
+    if (datalog.burst.sampleTick < DATALOG_BURST_SAMPLE_TICKS)
+        return;
+    datalog.burst.sampleTick = 0;
+
+    uint32_t head = datalog.burst.head;
+
+    // End burst if the main loop fell behind; the closing absolute entry
+    // keeps the pulse count
+    if ((datalog.burst.sampleIndex == 0) &&
+        ((head - datalog.burst.tail) >= DATALOG_BURST_BLOCK_NUM))
+    {
+        datalog.burst.blockNum = 0;
+
+        return;
+    }
+
+    uint32_t pulseCount = getTubePulseCount();
+    uint32_t sample = pulseCount - datalog.burst.previousPulseCount;
+    if (sample > UINT16_MAX)
+        sample = UINT16_MAX;
+    datalog.burst.previousPulseCount = pulseCount;
+
+    datalog.burst.samples[head % DATALOG_BURST_BLOCK_NUM][datalog.burst.sampleIndex] = sample;
+    datalog.burst.sampleIndex++;
+
+    if (datalog.burst.sampleIndex >= DATALOG_BURST_SAMPLE_NUM)
+    {
+        datalog.burst.sampleIndex = 0;
+        datalog.burst.head = head + 1;
+        datalog.burst.blockNum--;
+    }
+}
+
 void updateDatalog(void)
 {
+    if (datalog.burst.enabled)
+    {
+        if (!datalog.read.active)
+            updateDatalogBurst();
+
+        return;
+    }
+
     uint32_t timeFast = getDeviceTimeFast();
     if (timeFast != datalog.previousTimeFast)
     {
@@ -430,12 +723,152 @@ static void readPage(void)
     datalog.read.pageOffset = 0;
 }
 
+static void resetDatalogReadDecoder(void)
+{
+    datalog.read.deltaOfDelta = false;
+    datalog.read.delta = 0;
+    datalog.read.runCount = 0;
+}
+
+static uint32_t getPageBaseAt(uint32_t headPageBase, uint32_t pageIndex)
+{
+    return DATALOG_BASE + ((headPageBase - DATALOG_BASE) + pageIndex * DATALOG_PAGE_SIZE) % DATALOG_SIZE;
+}
+
+static bool getPageStartTime(uint32_t pageBase, uint32_t *time)
+{
+    const uint8_t *page = readFlash(pageBase, DATALOG_PAGE_START_SCAN_SIZE);
+
+    // Page rollover always writes an absolute entry first, optionally preceded by a session start
+    for (uint32_t pageOffset = 0; pageOffset <= (DATALOG_PAGE_START_SCAN_SIZE - 9); pageOffset++)
+    {
+        uint8_t c = page[pageOffset];
+
+        if (c < DATALOG_ENTRY_ABSOLUTE)
+            return false;
+        else if (isAbsoluteEntry(c))
+        {
+            decodeFixedUInt32(page + pageOffset + 1, time);
+
+            return true;
+        }
+        else if (c == DATALOG_ENTRY_EMPTY)
+            return false;
+    }
+
+    return false;
+}
+
+static bool isPageWritable(uint32_t pageBase)
+{
+    return readPageState(pageBase) == PAGESTATE_WRITABLE;
+}
+
+static bool isDatalogTail(uint32_t pageBase)
+{
+    // The writable page after a written one; the page following it may
+    // already be erased
+    return isPageWritable(pageBase) &&
+           !isPageWritable(getPreviousPage(pageBase));
+}
+
+static bool findDatalogTailFromHint(uint32_t *tailPageBase)
+{
+    // The last absolute entry before power off is on the write page
+    DatalogMarker marker;
+    if (!getSavedHistoryDatalogMarker(&marker) ||
+        (marker.pageBase < DATALOG_BASE) ||
+        (marker.pageBase >= DATALOG_END) ||
+        getFlashPageOffset(marker.pageBase) ||
+        !isDatalogTail(marker.pageBase))
+        return false;
+
+    *tailPageBase = marker.pageBase;
+
+    return true;
+}
+
+static bool findDatalogTailByBisection(uint32_t *tailPageBase)
+{
+    const uint32_t lastPageBase = DATALOG_END - DATALOG_PAGE_SIZE;
+
+    if (isPageWritable(DATALOG_BASE))
+    {
+        // Nothing written, the first page is the write page, or the last
+        // page is the write page and the first one is pre-erased
+        if (isPageWritable(lastPageBase) &&
+            !isPageWritable(getPreviousPage(lastPageBase)))
+            *tailPageBase = lastPageBase;
+        else
+            *tailPageBase = DATALOG_BASE;
+
+        return true;
+    }
+
+    uint32_t low = 0;
+    uint32_t high = DATALOG_SIZE / DATALOG_PAGE_SIZE - 1;
+
+    if (isPageWritable(lastPageBase))
+    {
+        // Not wrapped: written pages, then writable pages
+        while ((high - low) > 1)
+        {
+            uint32_t middle = (low + high) / 2;
+
+            if (isPageWritable(getPageBaseAt(DATALOG_BASE, middle)))
+                high = middle;
+            else
+                low = middle;
+        }
+    }
+    else
+    {
+        // Wrapped: pages before the writable pages are newer than the
+        // first page, pages after them are older
+        uint32_t firstPageStartTime;
+        uint32_t pageStartTime;
+        if (!getPageStartTime(DATALOG_BASE, &firstPageStartTime) ||
+            !getPageStartTime(lastPageBase, &pageStartTime) ||
+            (pageStartTime >= firstPageStartTime))
+            return false;
+
+        while ((high - low) > 1)
+        {
+            uint32_t middle = (low + high) / 2;
+            uint32_t pageBase = getPageBaseAt(DATALOG_BASE, middle);
+
+            if (isPageWritable(pageBase))
+                high = middle;
+            else if (!getPageStartTime(pageBase, &pageStartTime))
+                return false;
+            else if (pageStartTime < firstPageStartTime)
+                high = middle;
+            else
+                low = middle;
+        }
+    }
+
+    *tailPageBase = getPageBaseAt(DATALOG_BASE, high);
+
+    return isDatalogTail(*tailPageBase);
+}
+
 static bool setDatalogTail(void)
 {
     // Gets most recent datalog page
+    uint32_t tailPageBase;
+    if (findDatalogTailFromHint(&tailPageBase) ||
+        findDatalogTailByBisection(&tailPageBase))
+    {
+        datalog.read.pageBase = tailPageBase;
+
+        return true;
+    }
+
+    // Fall back to a full scan, e.g. after the clock was set back
     for (uint32_t pageBase = DATALOG_BASE; pageBase < DATALOG_END; pageBase += DATALOG_PAGE_SIZE)
     {
-        if (readPageState(pageBase) == PAGESTATE_WRITABLE)
+        if (isDatalogTail(pageBase))
         {
             datalog.read.pageBase = pageBase;
 
@@ -464,7 +897,58 @@ static bool setDatalogHead(void)
     }
 }
 
-bool startDatalogRead(void)
+static void seekDatalogRead(uint32_t startTime)
+{
+    uint32_t headPageBase = datalog.read.pageBase;
+
+    // Count pages from head to tail
+    uint32_t pageNum = 1;
+    for (uint32_t pageBase = headPageBase;
+         readPageState(pageBase) == PAGESTATE_FULL;
+         pageBase = getNextPage(pageBase))
+        pageNum++;
+
+    // Binary search most recent page starting before startTime
+    uint32_t low = 0;
+    uint32_t lowTime = 0;
+    uint32_t high = pageNum;
+    uint32_t highTime = UINT32_MAX;
+
+    if (getPageStartTime(headPageBase, &lowTime) &&
+        (lowTime >= startTime))
+        return;
+
+    while ((high - low) > 1)
+    {
+        uint32_t middle = (low + high) / 2;
+        uint32_t pageStartTime;
+
+        if (getPageStartTime(getPageBaseAt(headPageBase, middle), &pageStartTime))
+        {
+            // Clock was set back: page start times are out of order, read from head
+            if ((pageStartTime < lowTime) ||
+                (pageStartTime > highTime))
+                return;
+
+            if (pageStartTime < startTime)
+            {
+                low = middle;
+                lowTime = pageStartTime;
+            }
+            else
+            {
+                high = middle;
+                highTime = pageStartTime;
+            }
+        }
+        else
+            high = middle;
+    }
+
+    datalog.read.pageBase = getPageBaseAt(headPageBase, low);
+}
+
+bool startDatalogRead(uint32_t startTime)
 {
     if (datalog.read.active)
         return false;
@@ -472,26 +956,94 @@ bool startDatalogRead(void)
     if (!setDatalogHead())
         return false;
 
+    // Write pending repeated deltas, so that they can be read
+    flushDatalogRun();
+
+    if (startTime)
+        seekDatalogRead(startTime);
+
     readPage();
+    resetDatalogReadDecoder();
 
     datalog.read.active = true;
 
     return true;
 }
 
-static void stopDatalogRead(void)
+bool getDatalogMarker(DatalogMarker *marker)
+{
+    if (!datalog.write.markerValid)
+        return false;
+
+    *marker = datalog.write.marker;
+
+    return true;
+}
+
+bool startDatalogReadFromMarker(const DatalogMarker *marker)
+{
+    if (datalog.read.active)
+        return false;
+
+    // Validate marker position
+    if ((marker->pageBase < DATALOG_BASE) ||
+        (marker->pageBase >= DATALOG_END) ||
+        getFlashPageOffset(marker->pageBase) ||
+        (marker->pageOffset > (DATALOG_PAGE_STATE_OFFSET - 9)))
+        return false;
+
+    // Validate page is part of the data log
+    PageState pageState = readPageState(marker->pageBase);
+    if ((pageState != PAGESTATE_FULL) && (pageState != PAGESTATE_WRITABLE))
+        return false;
+
+    // Validate absolute entry still matches marker
+    const uint8_t *entry = readFlash(marker->pageBase + marker->pageOffset, 9);
+    if (!isAbsoluteEntry(entry[0]))
+        return false;
+
+    Dose dose;
+    decodeFixedUInt32(entry + 1, &dose.time);
+    decodeFixedUInt32(entry + 5, &dose.pulseCount);
+    if ((dose.time != marker->dose.time) ||
+        (dose.pulseCount != marker->dose.pulseCount))
+        return false;
+
+    datalog.read.pageBase = marker->pageBase;
+    readPage();
+    resetDatalogReadDecoder();
+    datalog.read.pageOffset = marker->pageOffset;
+
+    datalog.read.active = true;
+
+    return true;
+}
+
+void stopDatalogRead(void)
 {
     static const uint8_t datalogEndOfRead = DATALOG_ENTRY_EMPTY;
 
     datalog.read.active = false;
     datalog.read.page = &datalogEndOfRead;
     datalog.read.pageOffset = 0;
+    datalog.read.runCount = 0;
 }
 
 bool readDatalog(DatalogRecord *record)
 {
     record->sessionStart = false;
 
+    // Repeated delta
+    if (datalog.read.runCount)
+    {
+        datalog.read.runCount--;
+
+        record->dose.pulseCount += datalog.read.delta;
+        record->dose.time += datalog.read.timeInterval;
+
+        return true;
+    }
+
     while (true)
     {
         // Out of data?
@@ -505,12 +1057,25 @@ bool readDatalog(DatalogRecord *record)
             readPage();
         }
 
+        uint8_t c = datalog.read.page[datalog.read.pageOffset];
+
         uint32_t value;
         uint32_t count = decodeVariableUInt32(datalog.read.page + datalog.read.pageOffset, &value);
         if (count)
         {
             datalog.read.pageOffset += count;
 
+            if (datalog.read.deltaOfDelta)
+            {
+                if ((c >= DATALOG_ENTRY_DELTAOFDELTA_RUN) &&
+                    (c < DATALOG_ENTRY_INCREMENTAL_2BYTES))
+                    datalog.read.runCount = (c - DATALOG_ENTRY_DELTAOFDELTA_RUN) + DATALOG_RUN_LENGTH_MIN - 1;
+                else
+                    datalog.read.delta = decodeDeltaOfDelta(value, datalog.read.delta);
+
+                value = datalog.read.delta;
+            }
+
             record->dose.pulseCount += value;
             record->dose.time += datalog.read.timeInterval;
 
@@ -518,13 +1083,35 @@ bool readDatalog(DatalogRecord *record)
         }
         else
         {
-            uint8_t c = datalog.read.page[datalog.read.pageOffset];
+            if ((c == DATALOG_ENTRY_BURST_8BIT) ||
+                (c == DATALOG_ENTRY_BURST_16BIT))
+            {
+                // One second of sub-second samples
+                const uint8_t *p = datalog.read.page + datalog.read.pageOffset;
+                uint32_t sampleNum = p[1];
+                uint32_t sampleSize = (c == DATALOG_ENTRY_BURST_16BIT) ? 2 : 1;
+
+                uint32_t sampleSum = 0;
+                for (uint32_t i = 0; i < sampleNum; i++)
+                {
+                    const uint8_t *sample = p + 2 + i * sampleSize;
+                    sampleSum += (sampleSize == 2) ? ((sample[0] << 8) | sample[1]) : sample[0];
+                }
+
+                datalog.read.pageOffset += 2 + sampleNum * sampleSize;
 
-            if (c < (DATALOG_ENTRY_ABSOLUTE + (DATALOG_LOGGINGMODE_NUM - 1)))
+                record->dose.pulseCount += sampleSum;
+                record->dose.time += 1;
+
+                return true;
+            }
+            else if (isAbsoluteEntry(c))
             {
                 // Time interval, absolute timestamp and pulse count value
-                uint32_t mode = (c - DATALOG_ENTRY_ABSOLUTE) + 1;
+                uint32_t mode = getAbsoluteEntryLoggingMode(c);
                 datalog.read.timeInterval = loggingModeIntervals[mode];
+                datalog.read.deltaOfDelta = isDeltaOfDeltaAbsoluteEntry(c);
+                datalog.read.delta = 0;
                 datalog.read.pageOffset++;
                 datalog.read.pageOffset += decodeFixedUInt32(datalog.read.page + datalog.read.pageOffset, &record->dose.time);
                 datalog.read.pageOffset += decodeFixedUInt32(datalog.read.page + datalog.read.pageOffset, &record->dose.pulseCount);
@@ -598,6 +1185,9 @@ void initDatalog(void)
     // Set write head
     datalog.write.pageBase = datalog.read.pageBase;
     datalog.write.pageOffset = alignAddressToFlashWordSize(datalog.read.pageOffset);
+
+    // Pre-erase next page
+    requestFlashErase(getNextPage(datalog.write.pageBase));
 }
 
 // Logging mode menu
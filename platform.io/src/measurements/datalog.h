@@ -15,11 +15,20 @@
 
 #include "../measurements/pulses.h"
 
+#define DATALOG_BURST_TIME_MAX 600
+
 typedef struct {
     bool sessionStart;
     Dose dose;
 } DatalogRecord;
 
+typedef struct
+{
+    uint32_t pageBase;
+    uint32_t pageOffset;
+    Dose dose;
+} DatalogMarker;
+
 void initDatalog(void);
 
 void resetDatalog(void);
@@ -30,8 +39,15 @@ void writeDatalogTimeChange(void);
 void clearDatalog(void);
 void updateDatalog(void);
 
-bool startDatalogRead(void);
+bool startDatalogBurst(uint32_t time);
+void onDatalogTick(void);
+
+bool startDatalogRead(uint32_t startTime);
 bool readDatalog(DatalogRecord *record);
+void stopDatalogRead(void);
+
+bool getDatalogMarker(DatalogMarker *marker);
+bool startDatalogReadFromMarker(const DatalogMarker *marker);
 
 void showDatalogMenu(void);
 
@@ -114,9 +114,13 @@ static MeasurementStyle getElectricFieldMeasurementStyle(void)
 
 static void drawElectricFieldValue(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = "";
-    buildValueString(valueString, unitString, electricField.value, &electricFieldUnits, electricFieldMinMetricPrefix);
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    buildValueString(&valueBuffer, &unitBuffer, electricField.value, &electricFieldUnits, electricFieldMinMetricPrefix);
 
     drawTitleBar(getString(STRING_ELECTRIC_FIELD));
     drawMeasurementValue(valueString, unitString, 0, getElectricFieldMeasurementStyle());
@@ -124,14 +128,19 @@ static void drawElectricFieldValue(void)
 
 static void drawElectricFieldTab(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = " ";
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
     const char *keyString = NULL;
 
     switch (electricFieldTab)
     {
     case ELECTRIC_FIELD_TAB_MAX:
-        buildValueString(valueString, unitString, electricField.maxValue, &electricFieldUnits, electricFieldMinMetricPrefix);
+        buildValueString(&valueBuffer, &unitBuffer, electricField.maxValue, &electricFieldUnits, electricFieldMinMetricPrefix);
 
         keyString = getString(STRING_MAX);
 
@@ -139,7 +148,7 @@ static void drawElectricFieldTab(void)
 
     case ELECTRIC_FIELD_TAB_MAGNETIC:
     {
-        buildValueString(valueString, unitString, getMagneticField(), &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, getMagneticField(), &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
 
         keyString = getString(STRING_MAGNETIC_FIELD);
 
@@ -212,10 +221,14 @@ static const char *onElectricFieldAlarmMenuGetOption(menu_size_t index, MenuStyl
     if (index == 0)
         return getString(STRING_OFF);
 
-    char unitString[32] = " ";
-    strclr(menuOption);
-    buildValueString(menuOption, unitString, electricFieldAlerts[index], &electricFieldUnits, electricFieldMinMetricPrefix);
-    strcat(menuOption, unitString);
+    char unitString[32];
+    StrBuf optionBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
+    buildValueString(&optionBuffer, &unitBuffer, electricFieldAlerts[index], &electricFieldUnits, electricFieldMinMetricPrefix);
+    strbufString(&optionBuffer, unitString);
 
     return menuOption;
 }
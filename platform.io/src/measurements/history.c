@@ -12,6 +12,7 @@
 #include "../measurements/datalog.h"
 #include "../measurements/history.h"
 #include "../measurements/instantaneous.h"
+#include "../peripherals/flash.h"
 #include "../peripherals/rtc.h"
 #include "../peripherals/voice.h"
 #include "../system/cmath.h"
@@ -50,6 +51,17 @@ typedef struct
     uint8_t logValues[HISTORY_BIN_NUM];
 } HistoryState;
 
+typedef struct
+{
+    uint32_t time;
+    uint32_t binNum;
+    DatalogMarker datalogMarker;
+} HistorySnapshot;
+
+#define HISTORY_STATES_OFFSET sizeof(HistorySnapshot)
+#define HISTORY_ID_OFFSET (HISTORY_SIZE - HISTORY_ID_SIZE)
+#define HISTORY_ID_SIZE 8
+
 static const History histories[] = {
     {STRING_HISTORY_10_MINUTES, 10 * 60 / (HISTORY_BIN_NUM - 1), 10},
     {STRING_HISTORY_1_HOUR, 60 * 60 / (HISTORY_BIN_NUM - 1), 6},
@@ -61,8 +73,13 @@ static const History histories[] = {
 
 static HistoryState historyStates[HISTORY_TAB_NUM];
 
+_Static_assert((HISTORY_STATES_OFFSET + sizeof(historyStates)) <= (HISTORY_SNAPSHOT_SIZE - HISTORY_ID_SIZE),
+               "History snapshot does not fit in HISTORY_SNAPSHOT_SIZE");
+
 static HistoryTab historyTab;
 
+static const uint8_t historyId[HISTORY_ID_SIZE] = SETTINGS_VERSION;
+
 void resetHistory(void)
 {
     clearHistory();
@@ -114,7 +131,7 @@ static void updateLoadHistory(LoadHistoryState *state, uint8_t *logValues)
     logValues[state->binIndex] = getHistoryLogValue(rate);
 }
 
-void loadHistory(void)
+static void rebuildHistory(void)
 {
     uint32_t historyEnd = getDeviceTime();
 
@@ -122,17 +139,20 @@ void loadHistory(void)
     memset(states, 0, HISTORY_TAB_NUM * sizeof(LoadHistoryState));
 
     uint32_t historiesStart[HISTORY_TAB_NUM];
+    uint32_t readStartTime = historyEnd;
     for (uint32_t historyIndex = 0; historyIndex < HISTORY_TAB_NUM; historyIndex++)
     {
         uint32_t binInterval = histories[historyIndex].binInterval;
         historiesStart[historyIndex] = historyEnd - HISTORY_BIN_NUM * binInterval;
-    }
 
-#if defined(FAST_SYSTEM_CLOCK)
-    setFastSystemClock(true);
-#endif
+        // Skip data log pages older than the longest history
+        if (historiesStart[historyIndex] > historyEnd)
+            readStartTime = 0;
+        else if (historiesStart[historyIndex] < readStartTime)
+            readStartTime = historiesStart[historyIndex];
+    }
 
-    if (startDatalogRead())
+    if (startDatalogRead(readStartTime))
     {
         Dose prevDose;
         DatalogRecord record;
@@ -225,12 +245,212 @@ void loadHistory(void)
             }
         }
     }
+}
+
+// History snapshot
+
+static void closeHistoryBins(HistoryState *historyState, const History *history, uint32_t *binEnd, uint32_t time)
+{
+    if (time < *binEnd)
+        return;
+
+    uint32_t binInterval = history->binInterval;
+    uint32_t binNum = (time - *binEnd) / binInterval + 1;
+
+    float binRate = historyState->cumulativeTime ? historyState->cumulativePulseCount / historyState->cumulativeTime : 0;
+    uint8_t *logValues = historyState->logValues;
+
+    if (binNum <= HISTORY_BIN_NUM)
+    {
+        uint32_t binIndex = HISTORY_BIN_NUM - binNum;
+
+        memmove(logValues, logValues + binNum, binIndex);
+        memset(logValues + binIndex, 0, binNum);
+        logValues[binIndex] = getHistoryLogValue(binRate);
+    }
+    else
+        memset(logValues, 0, HISTORY_BIN_NUM);
+
+    *binEnd += binNum * binInterval;
+
+    historyState->cumulativeTime = 0;
+    historyState->cumulativePulseCount = 0;
+}
+
+static void accumulateHistory(HistoryState *historyState, const History *history, uint32_t *binEnd, uint32_t start, uint32_t end, float rate)
+{
+    while (start < end)
+    {
+        closeHistoryBins(historyState, history, binEnd, start);
+
+        uint32_t segmentEnd = (*binEnd < end) ? *binEnd : end;
+        uint32_t segmentTime = segmentEnd - start;
+
+        historyState->cumulativeTime += segmentTime;
+        historyState->cumulativePulseCount += rate * (float)segmentTime;
+
+        start = segmentEnd;
+    }
+}
+
+static bool readHistorySnapshotHeader(HistorySnapshot *snapshot)
+{
+    const uint8_t *id = readFlash(HISTORY_BASE + HISTORY_ID_OFFSET, HISTORY_ID_SIZE);
+    if (memcmp(id, historyId, HISTORY_ID_SIZE) != 0)
+        return false;
+
+    memcpy(snapshot, readFlash(HISTORY_BASE, sizeof(HistorySnapshot)), sizeof(HistorySnapshot));
+
+    return snapshot->binNum == HISTORY_BIN_NUM;
+}
+
+static bool readHistorySnapshot(HistorySnapshot *snapshot)
+{
+    if (!readHistorySnapshotHeader(snapshot))
+        return false;
+
+    memcpy(historyStates, readFlash(HISTORY_BASE + HISTORY_STATES_OFFSET, sizeof(historyStates)), sizeof(historyStates));
+
+    for (uint32_t historyIndex = 0; historyIndex < HISTORY_TAB_NUM; historyIndex++)
+    {
+        if (historyStates[historyIndex].timeInterval >= histories[historyIndex].binInterval)
+            return false;
+    }
+
+    return true;
+}
+
+static bool replayHistory(void)
+{
+    HistorySnapshot snapshot;
+    uint32_t historyEnd = getDeviceTime();
+
+    // Restore snapshot; copied before the datalog read, as readFlash() may reuse its buffer
+    if (!readHistorySnapshot(&snapshot) ||
+        (snapshot.time > historyEnd) ||
+        (snapshot.datalogMarker.dose.time > snapshot.time) ||
+        !startDatalogReadFromMarker(&snapshot.datalogMarker))
+    {
+        clearHistory();
+
+        return false;
+    }
+
+    uint32_t historiesStart[HISTORY_TAB_NUM];
+    uint32_t binsEnd[HISTORY_TAB_NUM];
+    for (uint32_t historyIndex = 0; historyIndex < HISTORY_TAB_NUM; historyIndex++)
+    {
+        uint32_t binInterval = histories[historyIndex].binInterval;
+
+        historiesStart[historyIndex] = historyEnd - HISTORY_BIN_NUM * binInterval;
+        if (historiesStart[historyIndex] < snapshot.time)
+            historiesStart[historyIndex] = snapshot.time;
+        binsEnd[historyIndex] = snapshot.time - historyStates[historyIndex].timeInterval + binInterval;
+    }
+
+    // Replay records written after the snapshot
+    DatalogRecord record;
+    if (readDatalog(&record))
+    {
+        Dose prevDose = record.dose;
+
+        while (readDatalog(&record))
+        {
+            reloadWatchdog();
+
+            if (!record.sessionStart)
+            {
+                for (uint32_t historyIndex = 0; historyIndex < HISTORY_TAB_NUM; historyIndex++)
+                {
+                    uint32_t historyStart = historiesStart[historyIndex];
+
+                    // Overlap record interval with history interval
+                    uint32_t recordStart = (prevDose.time > historyStart) ? prevDose.time : historyStart;
+                    uint32_t recordEnd = (record.dose.time < historyEnd) ? record.dose.time : historyEnd;
+
+                    if (recordStart < recordEnd)
+                    {
+                        uint32_t intervalTime = record.dose.time - prevDose.time;
+                        uint32_t intervalPulseCount = record.dose.pulseCount - prevDose.pulseCount;
+                        float intervalRate = (float)intervalPulseCount / (float)intervalTime;
+
+                        accumulateHistory(&historyStates[historyIndex],
+                                          &histories[historyIndex],
+                                          &binsEnd[historyIndex],
+                                          recordStart,
+                                          recordEnd,
+                                          intervalRate);
+                    }
+                }
+            }
+
+            prevDose = record.dose;
+        }
+    }
+
+    // Advance to current time
+    for (uint32_t historyIndex = 0; historyIndex < HISTORY_TAB_NUM; historyIndex++)
+    {
+        const History *history = &histories[historyIndex];
+        HistoryState *historyState = &historyStates[historyIndex];
+
+        closeHistoryBins(historyState, history, &binsEnd[historyIndex], historyEnd);
+
+        historyState->timeInterval = historyEnd - (binsEnd[historyIndex] - history->binInterval);
+    }
+
+    return true;
+}
+
+void loadHistory(void)
+{
+#if defined(FAST_SYSTEM_CLOCK)
+    setFastSystemClock(true);
+#endif
+
+    if (!replayHistory())
+        rebuildHistory();
 
 #if defined(FAST_SYSTEM_CLOCK)
     setFastSystemClock(false);
 #endif
 }
 
+void saveHistory(void)
+{
+    HistorySnapshot snapshot;
+
+    if (!getDatalogMarker(&snapshot.datalogMarker))
+        return;
+
+    snapshot.time = getDeviceTime();
+    snapshot.binNum = HISTORY_BIN_NUM;
+
+    eraseSavedHistory();
+
+    if (writeFlash(HISTORY_BASE, (uint8_t *)&snapshot, sizeof(snapshot)) &&
+        writeFlash(HISTORY_BASE + HISTORY_STATES_OFFSET, (uint8_t *)historyStates, sizeof(historyStates)))
+        writeFlash(HISTORY_BASE + HISTORY_ID_OFFSET, historyId, HISTORY_ID_SIZE);
+}
+
+void eraseSavedHistory(void)
+{
+    for (uint32_t pageBase = HISTORY_BASE; pageBase < HISTORY_END; pageBase += FLASH_PAGE_SIZE)
+        eraseFlash(pageBase);
+}
+
+bool getSavedHistoryDatalogMarker(DatalogMarker *marker)
+{
+    HistorySnapshot snapshot;
+
+    if (!readHistorySnapshotHeader(&snapshot))
+        return false;
+
+    *marker = snapshot.datalogMarker;
+
+    return true;
+}
+
 void updateHistory(void)
 {
     for (uint32_t historyIndex = 0; historyIndex < HISTORY_TAB_NUM; historyIndex++)
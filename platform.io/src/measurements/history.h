@@ -10,6 +10,7 @@
 #if !defined(HISTORY_H)
 #define HISTORY_H
 
+#include "../measurements/datalog.h"
 #include "../ui/view.h"
 
 void resetHistory(void);
@@ -17,6 +18,9 @@ void resetHistory(void);
 void clearHistory(void);
 
 void loadHistory(void);
+void saveHistory(void);
+void eraseSavedHistory(void);
+bool getSavedHistoryDatalogMarker(DatalogMarker *marker);
 
 void updateHistory(void);
 
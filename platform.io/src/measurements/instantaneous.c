@@ -17,7 +17,9 @@
 #include "../ui/menu.h"
 #include "../ui/system.h"
 
+#if !defined(INSTANTANEOUS_RATE_PERIODS_NUM)
 #define INSTANTANEOUS_RATE_PERIODS_NUM 60
+#endif
 #define INSTANTANEOUS_RATE_PULSE_COUNT_MIN 19 // For 50% confidence interval
 
 #define INSTANTANEOUS_RATE_CONFIDENCE_THRESHOLD 0.75F
@@ -38,10 +40,20 @@ static void clearInstantaneousRate(void);
 
 static const uint8_t instantaneousMinTimes[] = {0, 5, 60, 30, 10};
 
+typedef struct
+{
+    uint32_t firstTick;
+    uint32_t lastTick;
+    uint32_t cumulativePulseCount;
+} InstantaneousPeriod;
+
 static struct
 {
-    PulsePeriod periods[INSTANTANEOUS_RATE_PERIODS_NUM];
+    InstantaneousPeriod periods[INSTANTANEOUS_RATE_PERIODS_NUM];
+    uint32_t periodsHead;
     uint32_t periodsLength;
+    uint32_t periodsPulseCount;
+    uint32_t periodsBasePulseCount;
 
     Rate rate;
 
@@ -127,17 +139,50 @@ static void updateInstantaneousRateTab(void)
     }
 }
 
+// Period ring buffer (index 0 is the most recent period)
+
+static void enqueuePeriod(const PulsePeriod *period)
+{
+    instantaneous.periodsHead = (instantaneous.periodsHead + 1) % INSTANTANEOUS_RATE_PERIODS_NUM;
+
+    InstantaneousPeriod *instantaneousPeriod = &instantaneous.periods[instantaneous.periodsHead];
+
+    if (instantaneous.periodsLength < INSTANTANEOUS_RATE_PERIODS_NUM)
+        instantaneous.periodsLength++;
+    else
+        instantaneous.periodsBasePulseCount = instantaneousPeriod->cumulativePulseCount;
+
+    instantaneous.periodsPulseCount += period->pulseCount;
+
+    instantaneousPeriod->firstTick = period->firstTick;
+    instantaneousPeriod->lastTick = period->lastTick;
+    instantaneousPeriod->cumulativePulseCount = instantaneous.periodsPulseCount;
+}
+
+static const InstantaneousPeriod *getPeriod(uint32_t index)
+{
+    return &instantaneous.periods[(instantaneous.periodsHead + INSTANTANEOUS_RATE_PERIODS_NUM - index) % INSTANTANEOUS_RATE_PERIODS_NUM];
+}
+
+static uint32_t getPeriodsTime(uint32_t periodTick, uint32_t index)
+{
+    return ((periodTick - getPeriod(index)->firstTick) / SYSTICK_FREQUENCY) + 1;
+}
+
+static uint32_t getPeriodsPulseCount(uint32_t periodNum)
+{
+    uint32_t basePulseCount = (periodNum < instantaneous.periodsLength)
+                                  ? getPeriod(periodNum)->cumulativePulseCount
+                                  : instantaneous.periodsBasePulseCount;
+
+    return instantaneous.periodsPulseCount - basePulseCount;
+}
+
 void updateInstantaneousRate(uint32_t periodTick, PulsePeriod *period)
 {
     // Enqueue period
     if (period->pulseCount)
-    {
-        for (uint32_t i = (INSTANTANEOUS_RATE_PERIODS_NUM - 1); i > 0; i--)
-            instantaneous.periods[i] = instantaneous.periods[i - 1];
-        instantaneous.periods[0] = *period;
-        if (instantaneous.periodsLength < INSTANTANEOUS_RATE_PERIODS_NUM)
-            instantaneous.periodsLength++;
-    }
+        enqueuePeriod(period);
 
     // Instantaneous rate
     PulsePeriod averagingPeriod = {0, 0, 0};
@@ -146,24 +191,33 @@ void updateInstantaneousRate(uint32_t periodTick, PulsePeriod *period)
     uint32_t minPulseCount =
         (settings.instantaneousAveraging <= INSTANTANEOUSAVERAGING_ADAPTIVEPRECISION) ? INSTANTANEOUS_RATE_PULSE_COUNT_MIN : 0;
 
-    instantaneous.rate.time = 0;
-
-    for (uint32_t i = 0; i < instantaneous.periodsLength; i++)
+    // Binary search the shortest averaging window that satisfies both the
+    // time and pulse count minimums: both grow monotonically with the window
+    uint32_t low = 0;
+    uint32_t high = instantaneous.periodsLength;
+    while (low < high)
     {
-        uint32_t time = ((periodTick - instantaneous.periods[i].firstTick) / SYSTICK_FREQUENCY) + 1;
+        uint32_t middle = (low + high) / 2;
 
-        bool timeSatisfied = (time > minTime);
-        bool pulseSatisfied = (averagingPeriod.pulseCount > minPulseCount);
+        bool timeSatisfied = (getPeriodsTime(periodTick, middle) > minTime);
+        bool pulseSatisfied = (getPeriodsPulseCount(middle) > minPulseCount);
         if (timeSatisfied && pulseSatisfied)
-            break;
+            high = middle;
+        else
+            low = middle + 1;
+    }
 
-        averagingPeriod.firstTick = instantaneous.periods[i].firstTick;
-        if (!averagingPeriod.pulseCount)
-            averagingPeriod.lastTick = instantaneous.periods[i].lastTick;
-        averagingPeriod.pulseCount += instantaneous.periods[i].pulseCount;
+    uint32_t periodNum = low;
+    if (periodNum)
+    {
+        averagingPeriod.firstTick = getPeriod(periodNum - 1)->firstTick;
+        averagingPeriod.lastTick = getPeriod(0)->lastTick;
+        averagingPeriod.pulseCount = getPeriodsPulseCount(periodNum);
 
-        instantaneous.rate.time = time;
+        instantaneous.rate.time = getPeriodsTime(periodTick, periodNum - 1);
     }
+    else
+        instantaneous.rate.time = 0;
 
     calculateRate(&instantaneous.rate, &averagingPeriod);
 
@@ -225,9 +279,13 @@ static MeasurementStyle getInstantaneousRateMeasurementStyle(void)
 
 static void drawInstantaneousRateValue(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = "";
-    buildValueString(valueString, unitString, instantaneous.rate.value, &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    buildValueString(&valueBuffer, &unitBuffer, instantaneous.rate.value, &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
 
     drawTitleBar(getString(STRING_INSTANTANEOUS));
     drawMeasurementValue(valueString, unitString, instantaneous.rate.confidence, getInstantaneousRateMeasurementStyle());
@@ -235,28 +293,33 @@ static void drawInstantaneousRateValue(void)
 
 static void drawInstantaneousRateTab(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = " ";
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
     const char *keyString = NULL;
 
     switch (instantaneousTab)
     {
     case INSTANTANEOUS_TAB_MAX:
-        buildValueString(valueString, unitString, instantaneous.maxValue, &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, instantaneous.maxValue, &pulseUnits[settings.doseUnits].rate, doseUnitsMinMetricPrefix[settings.doseUnits]);
 
         keyString = getString(STRING_MAX);
 
         break;
 
     case INSTANTANEOUS_TAB_RATE:
-        buildValueString(valueString, unitString, instantaneous.rate.value, &pulseUnits[settings.secondaryDoseUnits].rate, doseUnitsMinMetricPrefix[settings.secondaryDoseUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, instantaneous.rate.value, &pulseUnits[settings.secondaryDoseUnits].rate, doseUnitsMinMetricPrefix[settings.secondaryDoseUnits]);
 
         keyString = getString(STRING_RATE);
 
         break;
 
     case INSTANTANEOUS_TAB_CUMULATIVE:
-        buildValueString(valueString, unitString, getCumulativeDosePulseCount(), &pulseUnits[settings.doseUnits].dose, doseUnitsMinMetricPrefix[settings.doseUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, getCumulativeDosePulseCount(), &pulseUnits[settings.doseUnits].dose, doseUnitsMinMetricPrefix[settings.doseUnits]);
 
         keyString = getString(STRING_CUMULATIVE);
 
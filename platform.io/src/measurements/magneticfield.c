@@ -117,9 +117,13 @@ static MeasurementStyle getMagneticFieldMeasurementStyle(void)
 }
 static void drawMagneticFieldValue(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = "";
-    buildValueString(valueString, unitString, magneticField.value, &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    buildValueString(&valueBuffer, &unitBuffer, magneticField.value, &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
 
     drawTitleBar(getString(STRING_MAGNETIC_FIELD));
     drawMeasurementValue(valueString, unitString, 0, getMagneticFieldMeasurementStyle());
@@ -127,14 +131,19 @@ static void drawMagneticFieldValue(void)
 
 static void drawMagneticFieldTab(void)
 {
-    char valueString[32] = "";
-    char unitString[32] = " ";
+    char valueString[32];
+    char unitString[32];
+    StrBuf valueBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&valueBuffer, valueString, sizeof(valueString));
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
     const char *keyString = NULL;
 
     switch (magneticFieldTab)
     {
     case MAGNETIC_FIELD_TAB_MAX:
-        buildValueString(valueString, unitString, magneticField.maxValue, &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
+        buildValueString(&valueBuffer, &unitBuffer, magneticField.maxValue, &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
 
         keyString = getString(STRING_MAX);
 
@@ -142,7 +151,7 @@ static void drawMagneticFieldTab(void)
 
     case MAGNETIC_FIELD_TAB_ELECTRIC:
     {
-        buildValueString(valueString, unitString, getElectricField(), &electricFieldUnits, electricFieldMinMetricPrefix);
+        buildValueString(&valueBuffer, &unitBuffer, getElectricField(), &electricFieldUnits, electricFieldMinMetricPrefix);
 
         keyString = getString(STRING_ELECTRIC_FIELD);
 
@@ -245,10 +254,14 @@ static const char *onMagneticFieldAlarmMenuGetOption(menu_size_t index, MenuStyl
     if (index == 0)
         return getString(STRING_OFF);
 
-    char unitString[32] = " ";
-    strclr(menuOption);
-    buildValueString(menuOption, unitString, magneticFieldAlerts[index], &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
-    strcat(menuOption, unitString);
+    char unitString[32];
+    StrBuf optionBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
+    buildValueString(&optionBuffer, &unitBuffer, magneticFieldAlerts[index], &magneticFieldUnits[settings.magneticFieldUnits], magneticFieldMinMetricPrefix[settings.magneticFieldUnits]);
+    strbufString(&optionBuffer, unitString);
 
     return menuOption;
 }
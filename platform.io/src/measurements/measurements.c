@@ -9,6 +9,7 @@
 
 #include <float.h>
 
+#include "../bench/bench.h"
 #include "../measurements/average.h"
 #include "../measurements/cumulative.h"
 #include "../measurements/electricfield.h"
@@ -133,7 +134,7 @@ void updateMeasurements(void)
         return;
 
     // Measurements
-    updatePulses();
+    BENCH_PROBE(BENCH_PROBE_UPDATEPULSES, updatePulses());
 #if defined(EMFMETER)
     updateEMFMeter();
 #endif
@@ -223,24 +224,25 @@ bool isSoundIconActive(void)
 
 // Measurement views common
 
-void buildValueString(char *valueString, char *unitString, float value, const Unit *unit, int32_t minMetricPrefixIndex)
+void buildValueString(StrBuf *valueString, StrBuf *unitString, float value, const Unit *unit, int32_t minMetricPrefixIndex)
 {
     if (!unit->name[0] && (value < 10000.0F))
     {
         uint32_t intValue = (uint32_t)value;
 
-        strcatUInt32(valueString, intValue, 0);
-        strcpy(unitString, " ");
+        strbufUInt32(valueString, intValue, 0);
+        clearStrBuf(unitString);
+        strbufChar(unitString, ' ');
         if (intValue == 1)
-            strcat(unitString, getString(STRING_COUNT));
+            strbufString(unitString, getString(STRING_COUNT));
         else
-            strcat(unitString, getString(STRING_COUNTS));
+            strbufString(unitString, getString(STRING_COUNTS));
     }
     else
     {
-        strcatMetricValue(valueString, unitString, value * unit->scale, minMetricPrefixIndex);
+        strbufMetricValue(valueString, unitString, value * unit->scale, minMetricPrefixIndex);
 
-        strcat(unitString, unit->name[0] ? unit->name : getString(STRING_COUNTS));
+        strbufString(unitString, unit->name[0] ? unit->name : getString(STRING_COUNTS));
     }
 }
 
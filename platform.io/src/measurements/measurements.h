@@ -42,7 +42,7 @@ bool isAlertPending(void);
 bool isAlertFlashing(void);
 bool isSoundIconActive(void);
 
-void buildValueString(char *valueString, char *unitString, float value, const Unit *unit, int32_t minMetricPrefixIndex);
+void buildValueString(StrBuf *valueString, StrBuf *unitString, float value, const Unit *unit, int32_t minMetricPrefixIndex);
 void setMeasurementView(void);
 bool onMeasurementViewEvent(ViewEvent event);
 
@@ -7,6 +7,7 @@
  * License: MIT
  */
 
+#include "../bench/bench.h"
 #include "../measurements/average.h"
 #include "../measurements/cumulative.h"
 #include "../measurements/history.h"
@@ -285,7 +286,7 @@ void updatePulses(void)
     // Average rate, cumulative dose, history
     updateAverageRate(&compensatedPeriod);
     updateCumulativeDose(&compensatedPeriod);
-    updateHistory();
+    BENCH_PROBE(BENCH_PROBE_UPDATEHISTORY, updateHistory());
 }
 
 void setTubeTime(uint32_t value)
@@ -519,10 +520,13 @@ static const char *buildAlertMenuOption(menu_size_t index, const float *alerts,
     char unitString[32];
     float value = alerts[index] / scale;
 
-    strclr(menuOption);
-    strcpy(unitString, " ");
-    buildValueString(menuOption, unitString, value, unit, doseUnitsMinMetricPrefix[settings.doseUnits]);
-    strcat(menuOption, unitString);
+    StrBuf optionBuffer;
+    StrBuf unitBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    initStrBuf(&unitBuffer, unitString, sizeof(unitString));
+    strbufChar(&unitBuffer, ' ');
+    buildValueString(&optionBuffer, &unitBuffer, value, unit, doseUnitsMinMetricPrefix[settings.doseUnits]);
+    strbufString(&optionBuffer, unitString);
 
     return menuOption;
 }
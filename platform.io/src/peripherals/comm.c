@@ -17,6 +17,7 @@
 #include "../measurements/measurements.h"
 #include "../peripherals/display.h"
 #include "../peripherals/comm.h"
+#include "../peripherals/flash.h"
 #include "../peripherals/rtc.h"
 #include "../peripherals/tube.h"
 #include "../system/cmath.h"
@@ -27,11 +28,52 @@
 
 #define START_BOOTLOADER_TIME_MS 200
 
-#define DATALOG_MAX_RECORDS_PER_TX 2
+#define DATALOG_RECORD_SIZE_MAX (2 + 10 + 1 + 10)
 #define DATALOG_MAX_SCAN_PER_TX 1000
 
+#define DATALOG_RAW_BLOCK_SIZE 256
+// Hex data between the ";[offset]," prefix and the ",[crc32]" suffix
+#define DATALOG_RAW_BYTES_PER_TX ((COMM_BUFFER_SIZE - (1 + 10 + 1) - (1 + 8) - 2) / 2)
+
+// ";[timestamp]" entries, leaving room for the closing "\r\n"
+#define PULSE_TIMESTAMPS_MAX_PER_TX ((COMM_BUFFER_SIZE - 1 - 2) / (1 + 10))
+#define PULSE_TIMESTAMPS_MAX_PER_RESPONSE 1024
+
+#define FIELD_NUM_MAX 8
+#define FIELD_SIZE_MAX 16
+
+#define SUBSCRIPTION_INTERVAL_MIN (SYSTICK_FREQUENCY / 10)
+#define SUBSCRIPTION_INTERVAL_DEFAULT SYSTICK_FREQUENCY
+
+typedef union
+{
+    uint32_t uint32Value;
+    float floatValue;
+    const char *stringValue;
+} FieldValue;
+
 Comm comm;
 
+// Appends to comm.buffer without rescanning it
+static StrBuf commResponse;
+
+static struct
+{
+    uint32_t fieldNum;
+    uint8_t fields[FIELD_NUM_MAX];
+
+    uint32_t fieldIndex;
+    FieldValue values[FIELD_NUM_MAX];
+} fieldRecord;
+
+static struct
+{
+    uint32_t fieldNum;
+    uint8_t fields[FIELD_NUM_MAX];
+    uint32_t interval;
+    uint32_t previousTick;
+} subscription;
+
 void initComm(void)
 {
     initCommHardware();
@@ -39,74 +81,222 @@ void initComm(void)
 
 void clearComm(bool open)
 {
+    // Resume logging if a data log download was interrupted
+    if ((comm.transmitState == TRANSMIT_DATALOG) ||
+        (comm.transmitState == TRANSMIT_DATALOG_RAW))
+        stopDatalogRead();
+    comm.transmitState = TRANSMIT_RESPONSE;
+
     comm.state = COMM_RX;
 
     strclr(comm.buffer);
 
     comm.bufferIndex = 0;
+
+    comm.receiveHead = 0;
+    comm.receiveTail = 0;
+    comm.receiveLineStart = 0;
+    comm.receiveLineNum = 0;
+    comm.processedLineNum = 0;
+    comm.receiveDiscard = false;
+
     comm.open = open;
+
+    subscription.fieldNum = 0;
+}
+
+// Receive queue
+
+static void terminateCommLine(void)
+{
+    uint32_t head = comm.receiveHead;
+
+    // With the queue full, the line is dropped and the next one is received
+    // as empty, so that it is answered with an error
+    if ((head - comm.receiveTail) >= COMM_RECEIVE_QUEUE_SIZE)
+    {
+        comm.receiveHead = comm.receiveLineStart;
+        comm.receiveDiscard = true;
+
+        return;
+    }
+
+    comm.receiveQueue[head % COMM_RECEIVE_QUEUE_SIZE] = '\0';
+    comm.receiveHead = head + 1;
+    comm.receiveLineStart = head + 1;
+    comm.receiveLineNum++;
+
+    comm.receiveDiscard = false;
+}
+
+void receiveComm(char c)
+{
+    if (c >= ' ')
+    {
+        uint32_t head = comm.receiveHead;
+
+        // Keep room for the line terminator
+        if (!comm.receiveDiscard &&
+            ((head - comm.receiveLineStart) < (COMM_BUFFER_SIZE - 1)) &&
+            ((head + 1 - comm.receiveTail) < COMM_RECEIVE_QUEUE_SIZE))
+        {
+            comm.receiveQueue[head % COMM_RECEIVE_QUEUE_SIZE] = c;
+            comm.receiveHead = head + 1;
+        }
+
+#if defined(GMC800)
+        if ((c == '>') && (comm.previousChar == '>'))
+            terminateCommLine();
+#endif
+    }
+    else if ((c == '\r') ||
+             ((c == '\n') &&
+              (comm.previousChar != '\r')))
+        terminateCommLine();
+
+    comm.previousChar = c;
+}
+
+void discardCommLine(void)
+{
+    // The line is received as empty, so that it is answered with an error
+    comm.receiveHead = comm.receiveLineStart;
+    comm.receiveDiscard = true;
+}
+
+static bool popCommLine(void)
+{
+    if (comm.processedLineNum == comm.receiveLineNum)
+        return false;
+
+    uint32_t tail = comm.receiveTail;
+    uint32_t index = 0;
+    char c;
+
+    do
+    {
+        c = comm.receiveQueue[tail++ % COMM_RECEIVE_QUEUE_SIZE];
+        comm.buffer[index++] = c;
+    } while (c != '\0');
+
+    comm.receiveTail = tail;
+    comm.processedLineNum++;
+
+    return true;
+}
+
+static void parseRequestId(const char **s)
+{
+    const char *t = *s;
+
+    strclr(comm.requestTag);
+
+    while (*t == ' ')
+        t++;
+
+    if (*t != '#')
+        return;
+
+    // The "#id " tag is echoed at the start of the response
+    uint32_t index = 0;
+    while ((*t != '\0') && (*t != ' '))
+    {
+        // Overlong IDs are left unparsed, so that the request fails
+        if (index > COMM_REQUEST_ID_SIZE_MAX)
+        {
+            strclr(comm.requestTag);
+
+            return;
+        }
+
+        comm.requestTag[index++] = *t++;
+    }
+
+    comm.requestTag[index++] = ' ';
+    comm.requestTag[index] = '\0';
+
+    *s = t;
+}
+
+// Responses
+
+static void clearCommResponse(void)
+{
+    initStrBuf(&commResponse, comm.buffer, COMM_BUFFER_SIZE);
+}
+
+static void pushCommTag(void)
+{
+    clearCommResponse();
+    strbufString(&commResponse, comm.requestTag);
 }
 
 static void pushCommOk(void)
 {
-    strcpy(comm.buffer, "OK");
+    pushCommTag();
+    strbufString(&commResponse, "OK");
     comm.transmitState = TRANSMIT_RESPONSE;
 }
 
 static void pushCommOkSpace(void)
 {
     pushCommOk();
-    strcatChar(comm.buffer, ' ');
+    strbufChar(&commResponse, ' ');
 }
 
 static void pushCommString(const char *value)
 {
     pushCommOkSpace();
-    strcat(comm.buffer, value);
+    strbufString(&commResponse, value);
 }
 
 static void pushCommUInt32(uint32_t value)
 {
     pushCommOkSpace();
-    strcatUInt32(comm.buffer, value, 0);
+    strbufUInt32(&commResponse, value, 0);
 }
 
-static void pushCommFloat(float value, uint32_t fractionalDecimals)
+// CRC-32 (IEEE 802.3, as in zlib)
+
+static uint32_t updateCRC32(uint32_t crc, const uint8_t *data, uint32_t size)
 {
-    pushCommOkSpace();
-    strcatFloat(comm.buffer, value, fractionalDecimals);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+
+        for (uint32_t j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+    }
+
+    return crc;
 }
 
-// GET commands
+// Fields
 
-enum GetAction
+enum Field
 {
-    GET_DEVICE_ID,
-    GET_DEVICE_POWER,
-    GET_DEVICE_BATTERY_VOLTAGE,
-    GET_DEVICE_TIME,
-    GET_DEVICE_TIME_ZONE,
-    GET_TUBE_TYPE,
-    GET_TUBE_TIME,
-    GET_TUBE_PULSE_COUNT,
-    GET_TUBE_RATE,
-    GET_TUBE_DEAD_TIME,
-    GET_TUBE_SENSITIVITY,
-    GET_TUBE_DEADTIMECOMPENSATION,
+    FIELD_DEVICE_POWER,
+    FIELD_DEVICE_BATTERY_VOLTAGE,
+    FIELD_DEVICE_TIME,
+    FIELD_DEVICE_TIME_ZONE,
+    FIELD_TUBE_TYPE,
+    FIELD_TUBE_TIME,
+    FIELD_TUBE_PULSE_COUNT,
+    FIELD_TUBE_RATE,
+    FIELD_TUBE_DEAD_TIME,
+    FIELD_TUBE_SENSITIVITY,
+    FIELD_TUBE_DEADTIMECOMPENSATION,
 #if defined(TUBE_HV_PWM)
-    GET_TUBE_HV_FREQUENCY,
-    GET_TUBE_HV_DUTY_CYCLE,
+    FIELD_TUBE_HV_FREQUENCY,
+    FIELD_TUBE_HV_DUTY_CYCLE,
 #endif
 #if defined(EMFMETER)
-    GET_ELECTRIC_FIELD,
-    GET_MAGNETIC_FIELD,
+    FIELD_ELECTRIC_FIELD,
+    FIELD_MAGNETIC_FIELD,
 #endif
-    GET_DATALOG,
-    GET_RANDOM_DATA
 };
 
-static const char *getTable[] = {
-    "deviceId",
+static const char *fieldTable[] = {
     "devicePower",
     "deviceBatteryVoltage",
     "deviceTime",
@@ -126,120 +316,334 @@ static const char *getTable[] = {
     "electricField",
     "magneticField",
 #endif
-    "datalog",
-    "randomData"};
+};
 
-void processCommGet(const char *s)
+static bool parseField(const char **s, uint8_t *field)
 {
-    for (size_t i = 0; i < ARRAY_SIZE(getTable); i++)
+    const char *t = *s;
+
+    for (size_t i = 0; i < ARRAY_SIZE(fieldTable); i++)
     {
-        if (!parseToken(&s, getTable[i]))
-            continue;
+        size_t length = strlen(fieldTable[i]);
 
-        switch ((enum GetAction)i)
+        if ((strncmp(t, fieldTable[i], length) == 0) &&
+            ((t[length] == '\0') || (t[length] == ' ') || (t[length] == ',')))
         {
-        case GET_DEVICE_ID:
-            pushCommString(commId);
-            strcatChar(comm.buffer, ';');
-            comm.transmitState = TRANSMIT_DEVICEID;
+            *s = t + length;
+            *field = i;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint32_t parseFields(const char **s, uint8_t *fields)
+{
+    const char *t = *s;
+
+    while (*t == ' ')
+        t++;
 
+    // Comma-separated list
+    uint32_t fieldNum = 0;
+    while (true)
+    {
+        if ((fieldNum >= FIELD_NUM_MAX) ||
+            !parseField(&t, &fields[fieldNum]))
+            return 0;
+
+        fieldNum++;
+
+        if (*t != ',')
             break;
 
-        case GET_DEVICE_POWER:
-            pushCommUInt32(isPoweredOn());
+        t++;
+    }
+
+    *s = t;
+
+    return fieldNum;
+}
+
+static uint32_t sampleFields(const uint8_t *fields, uint32_t fieldNum)
+{
+    // Sample all fields within one tick, for a consistent snapshot
+    syncTick();
+
+    uint32_t tick = currentTick;
+
+    fieldRecord.fieldNum = fieldNum;
+    fieldRecord.fieldIndex = 0;
+
+    for (uint32_t i = 0; i < fieldNum; i++)
+    {
+        FieldValue *value = &fieldRecord.values[i];
+
+        fieldRecord.fields[i] = fields[i];
+
+        switch ((enum Field)fields[i])
+        {
+        case FIELD_DEVICE_POWER:
+            value->uint32Value = isPoweredOn();
 
             break;
 
-        case GET_DEVICE_BATTERY_VOLTAGE:
-            pushCommFloat(getBatteryVoltage(), 3);
+        case FIELD_DEVICE_BATTERY_VOLTAGE:
+            value->floatValue = getBatteryVoltage();
 
             break;
 
-        case GET_DEVICE_TIME:
-            pushCommUInt32(getDeviceTime());
+        case FIELD_DEVICE_TIME:
+            value->uint32Value = getDeviceTime();
 
             break;
 
-        case GET_DEVICE_TIME_ZONE:
-            pushCommFloat(getDeviceTimeZone(), 1);
+        case FIELD_DEVICE_TIME_ZONE:
+            value->floatValue = getDeviceTimeZone();
 
             break;
 
-        case GET_TUBE_TYPE:
-            pushCommString(getTubeType());
+        case FIELD_TUBE_TYPE:
+            value->stringValue = getTubeType();
 
             break;
 
-        case GET_TUBE_TIME:
-            pushCommUInt32(getTubeTime());
+        case FIELD_TUBE_TIME:
+            value->uint32Value = getTubeTime();
 
             break;
 
-        case GET_TUBE_PULSE_COUNT:
-            pushCommUInt32(getTubePulseCount());
+        case FIELD_TUBE_PULSE_COUNT:
+            value->uint32Value = getTubePulseCount();
 
             break;
 
-        case GET_TUBE_RATE:
-            pushCommFloat(60.0F * getInstantaneousRate(), 3);
+        case FIELD_TUBE_RATE:
+            value->floatValue = 60.0F * getInstantaneousRate();
 
             break;
 
-        case GET_TUBE_DEAD_TIME:
-            pushCommFloat(getTubeDeadTime(), 7);
+        case FIELD_TUBE_DEAD_TIME:
+            value->floatValue = getTubeDeadTime();
 
             break;
 
-        case GET_TUBE_SENSITIVITY:
-            pushCommFloat(getTubeSensitivity(), 3);
+        case FIELD_TUBE_SENSITIVITY:
+            value->floatValue = getTubeSensitivity();
 
             break;
 
-        case GET_TUBE_DEADTIMECOMPENSATION:
-            pushCommFloat(getTubeDeadTimeCompensation(), 7);
+        case FIELD_TUBE_DEADTIMECOMPENSATION:
+            value->floatValue = getTubeDeadTimeCompensation();
 
             break;
 
 #if defined(TUBE_HV_PWM)
-        case GET_TUBE_HV_FREQUENCY:
-            pushCommFloat(getTubeHVFrequency(), 2);
+        case FIELD_TUBE_HV_FREQUENCY:
+            value->floatValue = getTubeHVFrequency();
 
             break;
 
-        case GET_TUBE_HV_DUTY_CYCLE:
-            pushCommFloat(getTubeHVDutyCycle(), 5);
+        case FIELD_TUBE_HV_DUTY_CYCLE:
+            value->floatValue = getTubeHVDutyCycle();
 
             break;
 #endif
 
 #if defined(EMFMETER)
-        case GET_ELECTRIC_FIELD:
-            pushCommFloat(getElectricField(), 3);
+        case FIELD_ELECTRIC_FIELD:
+            value->floatValue = getElectricField();
 
             break;
 
-        case GET_MAGNETIC_FIELD:
-            pushCommFloat(getMagneticField(), 9);
+        case FIELD_MAGNETIC_FIELD:
+            value->floatValue = getMagneticField();
 
             break;
 #endif
+        }
+    }
+
+    return tick;
+}
+
+static bool pushFieldValues(void)
+{
+    while ((fieldRecord.fieldIndex < fieldRecord.fieldNum) &&
+           ((commResponse.len + FIELD_SIZE_MAX) < COMM_BUFFER_SIZE))
+    {
+        uint32_t index = fieldRecord.fieldIndex++;
+        FieldValue value = fieldRecord.values[index];
+
+        if (index)
+            strbufChar(&commResponse, ',');
+
+        switch ((enum Field)fieldRecord.fields[index])
+        {
+        case FIELD_DEVICE_POWER:
+        case FIELD_DEVICE_TIME:
+        case FIELD_TUBE_TIME:
+        case FIELD_TUBE_PULSE_COUNT:
+            strbufUInt32(&commResponse, value.uint32Value, 0);
+
+            break;
+
+        case FIELD_DEVICE_TIME_ZONE:
+            strbufFloat(&commResponse, value.floatValue, 1);
+
+            break;
+
+        case FIELD_TUBE_TYPE:
+            strbufString(&commResponse, value.stringValue);
+
+            break;
+
+        case FIELD_DEVICE_BATTERY_VOLTAGE:
+        case FIELD_TUBE_RATE:
+        case FIELD_TUBE_SENSITIVITY:
+#if defined(EMFMETER)
+        case FIELD_ELECTRIC_FIELD:
+#endif
+            strbufFloat(&commResponse, value.floatValue, 3);
+
+            break;
+
+        case FIELD_TUBE_DEAD_TIME:
+        case FIELD_TUBE_DEADTIMECOMPENSATION:
+            strbufFloat(&commResponse, value.floatValue, 7);
+
+            break;
+
+#if defined(TUBE_HV_PWM)
+        case FIELD_TUBE_HV_FREQUENCY:
+            strbufFloat(&commResponse, value.floatValue, 2);
+
+            break;
+
+        case FIELD_TUBE_HV_DUTY_CYCLE:
+            strbufFloat(&commResponse, value.floatValue, 5);
+
+            break;
+#endif
+
+#if defined(EMFMETER)
+        case FIELD_MAGNETIC_FIELD:
+            strbufFloat(&commResponse, value.floatValue, 9);
+
+            break;
+#endif
+        }
+    }
+
+    return (fieldRecord.fieldIndex >= fieldRecord.fieldNum);
+}
+
+static void pushFieldRecord(void)
+{
+    if (pushFieldValues())
+    {
+        strbufString(&commResponse, "\r\n");
+        comm.transmitState = TRANSMIT_RESPONSE;
+    }
+    else
+        comm.transmitState = TRANSMIT_FIELDS;
+}
+
+// GET commands
+
+enum GetAction
+{
+    GET_DEVICE_ID,
+    GET_DATALOG,
+    GET_DATALOG_RAW,
+    GET_PULSE_TIMESTAMPS,
+    GET_RANDOM_DATA
+};
+
+static const char *getTable[] = {
+    "deviceId",
+    "datalog",
+    "datalogRaw",
+    "pulseTimestamps",
+    "randomData"};
+
+void processCommGet(const char *s)
+{
+    // Field lists are answered from a single snapshot
+    uint8_t fields[FIELD_NUM_MAX];
+    uint32_t fieldNum = parseFields(&s, fields);
+    if (fieldNum)
+    {
+        sampleFields(fields, fieldNum);
+
+        pushCommOkSpace();
+        if (!pushFieldValues())
+            comm.transmitState = TRANSMIT_FIELDS;
+
+        return;
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(getTable); i++)
+    {
+        if (!parseToken(&s, getTable[i]))
+            continue;
+
+        switch ((enum GetAction)i)
+        {
+        case GET_DEVICE_ID:
+            pushCommString(commId);
+            strbufChar(&commResponse, ';');
+            comm.transmitState = TRANSMIT_DEVICEID;
+
+            break;
 
         case GET_DATALOG:
-            if (startDatalogRead())
+            comm.datalogStartTime = 0;
+            comm.datalogEndTime = UINT32_MAX;
+            comm.datalogMaxRecordNum = UINT32_MAX;
+            comm.datalogRecordNum = 0;
+            parseUInt32(&s, &comm.datalogStartTime);
+            parseUInt32(&s, &comm.datalogEndTime);
+            parseUInt32(&s, &comm.datalogMaxRecordNum);
+
+            if (startDatalogRead(comm.datalogStartTime))
             {
-                comm.datalogStartTime = 0;
-                comm.datalogEndTime = UINT32_MAX;
-                comm.datalogMaxRecordNum = UINT32_MAX;
-                comm.datalogRecordNum = 0;
-                parseUInt32(&s, &comm.datalogStartTime);
-                parseUInt32(&s, &comm.datalogEndTime);
-                parseUInt32(&s, &comm.datalogMaxRecordNum);
                 pushCommOk();
-                strcat(comm.buffer, " time,tubePulseCount");
+                strbufString(&commResponse, " time,tubePulseCount");
                 comm.transmitState = TRANSMIT_DATALOG;
             }
             break;
 
+        case GET_DATALOG_RAW:
+        {
+            uint32_t fromPage = 0;
+            parseUInt32(&s, &fromPage);
+
+            if ((fromPage < (DATALOG_SIZE / FLASH_PAGE_SIZE)) &&
+                startDatalogRead(0))
+            {
+                comm.datalogRawOffset = fromPage * FLASH_PAGE_SIZE;
+                pushCommOkSpace();
+                strbufUInt32(&commResponse, FLASH_PAGE_SIZE, 0);
+                strbufChar(&commResponse, ',');
+                strbufUInt32(&commResponse, DATALOG_SIZE / FLASH_PAGE_SIZE, 0);
+                strbufChar(&commResponse, ',');
+                strbufUInt32(&commResponse, FLASH_WORD_SIZE, 0);
+                comm.transmitState = TRANSMIT_DATALOG_RAW;
+            }
+
+            break;
+        }
+
+        case GET_PULSE_TIMESTAMPS:
+            pushCommUInt32(getTubePulseTimestampLostNum());
+            comm.pulseTimestampNum = 0;
+            comm.transmitState = TRANSMIT_PULSE_TIMESTAMPS;
+
+            break;
+
         case GET_RANDOM_DATA:
             pushCommOk();
             for (uint32_t j = 0; j < 16; j++)
@@ -248,8 +652,8 @@ void processCommGet(const char *s)
                 if (value < 0)
                     break;
                 if (j == 0)
-                    strcatChar(comm.buffer, ' ');
-                strcatUInt8Hex(comm.buffer, value);
+                    strbufChar(&commResponse, ' ');
+                strbufUInt8Hex(&commResponse, value);
             }
 
             break;
@@ -272,6 +676,7 @@ enum SetAction
     SET_TUBE_HV_FREQUENCY,
     SET_TUBE_HV_DUTYCYCLE,
 #endif
+    SET_DATALOG_BURST,
     SET_NONE
 };
 
@@ -285,6 +690,7 @@ static const char *setTable[] = {
     "tubeHVFrequency",
     "tubeHVDutyCycle",
 #endif
+    "datalogBurst",
 };
 
 void processCommSet(const char *s)
@@ -358,6 +764,12 @@ void processCommSet(const char *s)
             break;
 #endif
 
+        case SET_DATALOG_BURST:
+            if (parseUInt32(&s, &intValue) && startDatalogBurst(intValue))
+                pushCommOk();
+
+            break;
+
         default:
             break;
         }
@@ -366,6 +778,123 @@ void processCommSet(const char *s)
     }
 }
 
+// SUBSCRIBE command
+
+void processCommSubscribe(const char *s)
+{
+    uint8_t fields[FIELD_NUM_MAX];
+    uint32_t fieldNum = parseFields(&s, fields);
+
+    uint32_t interval = SUBSCRIPTION_INTERVAL_DEFAULT;
+    parseUInt32(&s, &interval);
+
+    while (*s == ' ')
+        s++;
+
+    if (!fieldNum ||
+        (interval < SUBSCRIPTION_INTERVAL_MIN) ||
+        *s)
+        return;
+
+    subscription.fieldNum = fieldNum;
+    memcpy(subscription.fields, fields, fieldNum);
+    subscription.interval = interval;
+    subscription.previousTick = currentTick;
+
+    pushCommOk();
+}
+
+static bool isSubscriptionDue(void)
+{
+    return subscription.fieldNum &&
+           ((currentTick - subscription.previousTick) >= subscription.interval);
+}
+
+static void transmitSubscriptionRecord(void)
+{
+    uint32_t tick = currentTick;
+
+    subscription.previousTick += subscription.interval;
+    if ((tick - subscription.previousTick) >= subscription.interval)
+        subscription.previousTick = tick;
+
+    tick = sampleFields(subscription.fields, subscription.fieldNum);
+
+    clearCommResponse();
+    strbufString(&commResponse, "DATA ");
+    strbufUInt32(&commResponse, tick, 0);
+    strbufChar(&commResponse, ',');
+
+    pushFieldRecord();
+
+    transmitComm();
+}
+
+static void processCommRequest(void)
+{
+    const char *s = comm.buffer;
+    comm.transmitState = TRANSMIT_ERROR;
+
+    parseRequestId(&s);
+
+    if (parseToken(&s, "GET"))
+        processCommGet(s);
+    else if (parseToken(&s, "SET"))
+        processCommSet(s);
+    else if (parseToken(&s, "SUBSCRIBE"))
+        processCommSubscribe(s);
+    else if (parseToken(&s, "UNSUBSCRIBE"))
+    {
+        subscription.fieldNum = 0;
+        pushCommOk();
+    }
+    else if (parseToken(&s, "RESET datalog"))
+    {
+        clearDatalog();
+        pushCommOk();
+    }
+#if defined(BOOTLOADER)
+    else if (parseToken(&s, "START bootloader"))
+    {
+        pushCommOk();
+        comm.transmitState = TRANSMIT_BOOTLOADER;
+    }
+#endif
+#if defined(GMC800)
+    else if (parseToken(&s, "<GETVER>>"))
+    {
+        clearCommResponse();
+        strbufString(&commResponse, "GMC-800Re RADP");
+        comm.transmitState = TRANSMIT_RAW;
+    }
+    else if (parseToken(&s, "<GETSERIAL>>"))
+    {
+        clearCommResponse();
+        strbufString(&commResponse, "\xde\xca\xfb\xad\xc0\xff\xee");
+        comm.transmitState = TRANSMIT_RAW;
+    }
+    else if (parseToken(&s, "<BOOTLOADER1>>"))
+    {
+        clearCommResponse();
+        strbufString(&commResponse, "BOOTLOADER");
+        comm.transmitState = TRANSMIT_BOOTLOADER;
+    }
+#endif
+
+    if (comm.transmitState <= TRANSMIT_BOOTLOADER)
+        strbufString(&commResponse, "\r\n");
+    else if (comm.transmitState == TRANSMIT_RAW)
+        comm.transmitState = TRANSMIT_RESPONSE;
+    else if (comm.transmitState == TRANSMIT_ERROR)
+    {
+        pushCommTag();
+        strbufString(&commResponse, "ERROR\r\n");
+        comm.transmitState = TRANSMIT_RESPONSE;
+    }
+
+    transmitComm();
+}
+
 // Update comm
 
 void updateComm(void)
@@ -387,61 +916,18 @@ void updateComm(void)
     // Process comm events
     switch (comm.state)
     {
-    case COMM_RX_READY:
-    {
-        const char *s = comm.buffer;
-        comm.transmitState = TRANSMIT_ERROR;
-
-        if (parseToken(&s, "GET"))
-            processCommGet(s);
-        else if (parseToken(&s, "SET"))
-            processCommSet(s);
-        else if (parseToken(&s, "RESET datalog"))
-        {
-            clearDatalog();
-            pushCommOk();
-        }
-#if defined(BOOTLOADER)
-        else if (parseToken(&s, "START bootloader"))
-        {
-            pushCommOk();
-            comm.transmitState = TRANSMIT_BOOTLOADER;
-        }
-#endif
-#if defined(GMC800)
-        else if (parseToken(&s, "<GETVER>>"))
-        {
-            strcpy(comm.buffer, "GMC-800Re RADP");
-            comm.transmitState = TRANSMIT_RAW;
-        }
-        else if (parseToken(&s, "<GETSERIAL>>"))
-        {
-            strcpy(comm.buffer, "\xde\xca\xfb\xad\xc0\xff\xee");
-            comm.transmitState = TRANSMIT_RAW;
-        }
-        else if (parseToken(&s, "<BOOTLOADER1>>"))
-        {
-            strcpy(comm.buffer, "BOOTLOADER");
-            comm.transmitState = TRANSMIT_BOOTLOADER;
-        }
-#endif
-
-        if (comm.transmitState <= TRANSMIT_BOOTLOADER)
-            strcat(comm.buffer, "\r\n");
-        else if (comm.transmitState == TRANSMIT_RAW)
-            comm.transmitState = TRANSMIT_RESPONSE;
-        else if (comm.transmitState == TRANSMIT_ERROR)
-        {
-            strcpy(comm.buffer, "ERROR\r\n");
-            comm.transmitState = TRANSMIT_RESPONSE;
-        }
-
-        transmitComm();
+    case COMM_RX:
+        // Queued requests are answered in order, records in between
+        if (popCommLine())
+            processCommRequest();
+        else if (isSubscriptionDue())
+            transmitSubscriptionRecord();
 
         break;
-    }
 
     case COMM_TX_READY:
+        openStrBuf(&commResponse, comm.buffer, COMM_BUFFER_SIZE);
+
         switch (comm.transmitState)
         {
 #if defined(BOOTLOADER)
@@ -467,8 +953,8 @@ void updateComm(void)
         {
             char deviceId[32];
             getDeviceId(deviceId);
-            strcat(comm.buffer, deviceId);
-            strcat(comm.buffer, "\r\n");
+            strbufString(&commResponse, deviceId);
+            strbufString(&commResponse, "\r\n");
             comm.transmitState = TRANSMIT_RESPONSE;
 
             transmitComm();
@@ -478,14 +964,15 @@ void updateComm(void)
 
         case TRANSMIT_DATALOG:
         {
-            uint32_t sentRecordNum = 0;
             uint32_t readRecordNum = 0;
 
-            while ((sentRecordNum < DATALOG_MAX_RECORDS_PER_TX) && (readRecordNum < DATALOG_MAX_SCAN_PER_TX))
+            // Fill the buffer, so each transmission carries a full chunk
+            while (((commResponse.len + DATALOG_RECORD_SIZE_MAX) < COMM_BUFFER_SIZE) &&
+                   (readRecordNum < DATALOG_MAX_SCAN_PER_TX))
             {
                 if (!readDatalog(&comm.datalogRecord))
                 {
-                    strcat(comm.buffer, "\r\n");
+                    strbufString(&commResponse, "\r\n");
                     comm.transmitState = TRANSMIT_RESPONSE;
 
                     break;
@@ -496,13 +983,12 @@ void updateComm(void)
                     (comm.datalogRecordNum < comm.datalogMaxRecordNum))
                 {
                     if (comm.datalogRecord.sessionStart)
-                        strcatChar(comm.buffer, ';');
-                    strcatChar(comm.buffer, ';');
-                    strcatUInt32(comm.buffer, comm.datalogRecord.dose.time, 0);
-                    strcatChar(comm.buffer, ',');
-                    strcatUInt32(comm.buffer, comm.datalogRecord.dose.pulseCount, 0);
+                        strbufChar(&commResponse, ';');
+                    strbufChar(&commResponse, ';');
+                    strbufUInt32(&commResponse, comm.datalogRecord.dose.time, 0);
+                    strbufChar(&commResponse, ',');
+                    strbufUInt32(&commResponse, comm.datalogRecord.dose.pulseCount, 0);
 
-                    sentRecordNum++;
                     comm.datalogRecordNum++;
                 }
 
@@ -514,6 +1000,88 @@ void updateComm(void)
             break;
         }
 
+        case TRANSMIT_DATALOG_RAW:
+        {
+            uint32_t blockOffset = comm.datalogRawOffset % DATALOG_RAW_BLOCK_SIZE;
+
+            if (blockOffset == 0)
+            {
+                if (comm.datalogRawOffset >= DATALOG_SIZE)
+                {
+                    stopDatalogRead();
+
+                    strbufString(&commResponse, "\r\n");
+                    comm.transmitState = TRANSMIT_RESPONSE;
+
+                    transmitComm();
+
+                    break;
+                }
+
+                strbufChar(&commResponse, ';');
+                strbufUInt32(&commResponse, comm.datalogRawOffset, 0);
+                strbufChar(&commResponse, ',');
+
+                comm.datalogRawCRC = 0xffffffff;
+            }
+
+            uint32_t count = DATALOG_RAW_BLOCK_SIZE - blockOffset;
+            if (count > DATALOG_RAW_BYTES_PER_TX)
+                count = DATALOG_RAW_BYTES_PER_TX;
+
+            const uint8_t *data = readFlash(DATALOG_BASE + comm.datalogRawOffset,
+                                            count);
+            strbufHexData(&commResponse, data, count);
+            comm.datalogRawCRC = updateCRC32(comm.datalogRawCRC,
+                                             data,
+                                             count);
+
+            comm.datalogRawOffset += count;
+
+            if ((blockOffset + count) == DATALOG_RAW_BLOCK_SIZE)
+            {
+                strbufChar(&commResponse, ',');
+                strbufUInt32Hex(&commResponse, ~comm.datalogRawCRC);
+            }
+
+            transmitComm();
+
+            break;
+        }
+
+        case TRANSMIT_FIELDS:
+            pushFieldRecord();
+
+            transmitComm();
+
+            break;
+
+        case TRANSMIT_PULSE_TIMESTAMPS:
+        {
+            for (uint32_t i = 0; i < PULSE_TIMESTAMPS_MAX_PER_TX; i++)
+            {
+                uint32_t timestamp;
+
+                if ((comm.pulseTimestampNum >= PULSE_TIMESTAMPS_MAX_PER_RESPONSE) ||
+                    !popTubePulseTimestamp(&timestamp))
+                {
+                    strbufString(&commResponse, "\r\n");
+                    comm.transmitState = TRANSMIT_RESPONSE;
+
+                    break;
+                }
+
+                strbufChar(&commResponse, ';');
+                strbufUInt32(&commResponse, timestamp, 0);
+
+                comm.pulseTimestampNum++;
+            }
+
+            transmitComm();
+
+            break;
+        }
+
         default:
         {
             comm.state = COMM_RX;
@@ -15,14 +15,15 @@
 
 #include "../measurements/datalog.h"
 
-#define COMM_BUFFER_SIZE 64
+#define COMM_BUFFER_SIZE 128
+#define COMM_RECEIVE_QUEUE_SIZE 256
+#define COMM_REQUEST_ID_SIZE_MAX 8
 
 extern const char *const commId;
 
 typedef enum
 {
     COMM_RX,
-    COMM_RX_READY,
     COMM_TX,
     COMM_TX_READY,
 } CommState;
@@ -33,8 +34,11 @@ typedef enum
     TRANSMIT_BOOTLOADER = 1,
     TRANSMIT_DEVICEID = 2,
     TRANSMIT_DATALOG = 3,
-    TRANSMIT_RAW = 4,
-    TRANSMIT_ERROR = 5,
+    TRANSMIT_DATALOG_RAW = 4,
+    TRANSMIT_PULSE_TIMESTAMPS = 5,
+    TRANSMIT_RAW = 6,
+    TRANSMIT_FIELDS = 7,
+    TRANSMIT_ERROR = 8,
 } TransmitState;
 
 typedef struct
@@ -44,15 +48,28 @@ typedef struct
     volatile uint32_t bufferIndex;
     char buffer[COMM_BUFFER_SIZE];
 
+    volatile uint32_t receiveHead;
+    volatile uint32_t receiveTail;
+    volatile uint32_t receiveLineStart;
+    volatile uint32_t receiveLineNum;
+    uint32_t processedLineNum;
+    volatile bool receiveDiscard;
+    volatile char receiveQueue[COMM_RECEIVE_QUEUE_SIZE];
+
     volatile bool open;
     char previousChar;
 
+    char requestTag[COMM_REQUEST_ID_SIZE_MAX + 3];
+
     volatile TransmitState transmitState;
     uint32_t datalogStartTime;
     uint32_t datalogEndTime;
     uint32_t datalogMaxRecordNum;
     uint32_t datalogRecordNum;
     DatalogRecord datalogRecord;
+    uint32_t datalogRawOffset;
+    uint32_t datalogRawCRC;
+    uint32_t pulseTimestampNum;
 } Comm;
 
 extern Comm comm;
@@ -64,6 +81,8 @@ void openComm(void);
 void closeComm(void);
 void clearComm(bool open);
 
+void receiveComm(char c);
+void discardCommLine(void);
 void transmitComm(void);
 
 void updateComm(void);
@@ -45,9 +45,11 @@ static const char *onDisplayContrastMenuGetOption(menu_size_t index, MenuStyle *
 {
     *menuStyle = (index == settings.displayContrast);
 
-    strcpy(menuOption, getString(STRING_CONTRAST_LEVEL));
-    strcatChar(menuOption, ' ');
-    strcatUInt32(menuOption, index + 1, 0);
+    StrBuf optionBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    strbufString(&optionBuffer, getString(STRING_CONTRAST_LEVEL));
+    strbufChar(&optionBuffer, ' ');
+    strbufUInt32(&optionBuffer, index + 1, 0);
 
     return menuOption;
 }
@@ -42,4 +42,9 @@ void refreshDisplay(void);
 
 void showDisplayMenu(void);
 
+#if defined(SIMULATOR) && !defined(BENCHMARK)
+void setDisplayViewName(const char *name);
+void onDisplayFrame(void);
+#endif
+
 #endif
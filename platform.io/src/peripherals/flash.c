@@ -0,0 +1,93 @@
+/*
+ * Rad Pro
+ * Flash memory
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#include "../peripherals/display.h"
+#include "../peripherals/flash.h"
+
+#define FLASH_ERASE_QUEUE_SIZE 2
+
+static struct
+{
+    uint32_t eraseQueue[FLASH_ERASE_QUEUE_SIZE];
+    uint32_t eraseQueueLength;
+} flash;
+
+bool isFlashEmpty(uint32_t address, uint32_t count)
+{
+    const uint8_t *p = readFlash(address, count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (p[i] != 0xff)
+            return false;
+    }
+
+    return true;
+}
+
+// Erase scheduler
+
+static int32_t findFlashEraseRequest(uint32_t pageBase)
+{
+    for (uint32_t i = 0; i < flash.eraseQueueLength; i++)
+    {
+        if (flash.eraseQueue[i] == pageBase)
+            return i;
+    }
+
+    return -1;
+}
+
+static void removeFlashEraseRequest(uint32_t index)
+{
+    flash.eraseQueueLength--;
+
+    for (uint32_t i = index; i < flash.eraseQueueLength; i++)
+        flash.eraseQueue[i] = flash.eraseQueue[i + 1];
+}
+
+static void eraseFlashIfNotEmpty(uint32_t pageBase)
+{
+    if (!isFlashEmpty(pageBase, FLASH_PAGE_SIZE))
+        eraseFlash(pageBase);
+}
+
+void requestFlashErase(uint32_t pageBase)
+{
+    if (findFlashEraseRequest(pageBase) >= 0)
+        return;
+
+    // Queue full: erase oldest request now
+    if (flash.eraseQueueLength >= FLASH_ERASE_QUEUE_SIZE)
+    {
+        eraseFlashIfNotEmpty(flash.eraseQueue[0]);
+        removeFlashEraseRequest(0);
+    }
+
+    flash.eraseQueue[flash.eraseQueueLength++] = pageBase;
+}
+
+void completeFlashErase(uint32_t pageBase)
+{
+    int32_t index = findFlashEraseRequest(pageBase);
+    if (index >= 0)
+        removeFlashEraseRequest(index);
+
+    eraseFlashIfNotEmpty(pageBase);
+}
+
+void updateFlash(void)
+{
+    // Page erases stall the CPU: run them only while nobody is watching
+    if (!flash.eraseQueueLength || isDisplayEnabled())
+        return;
+
+    eraseFlashIfNotEmpty(flash.eraseQueue[0]);
+    removeFlashEraseRequest(0);
+}
@@ -23,7 +23,17 @@
 #define STATES_SIZE FLASH_PAGE_SIZE
 #define STATES_END (STATES_BASE + STATES_SIZE)
 
-#define DATALOG_BASE STATES_END
+#if defined(DISPLAY_MONOCHROME)
+#define HISTORY_SNAPSHOT_SIZE 0x400
+#else
+#define HISTORY_SNAPSHOT_SIZE 0x800
+#endif
+
+#define HISTORY_BASE STATES_END
+#define HISTORY_SIZE ((HISTORY_SNAPSHOT_SIZE + FLASH_PAGE_SIZE - 1) & ~(FLASH_PAGE_SIZE - 1))
+#define HISTORY_END (HISTORY_BASE + HISTORY_SIZE)
+
+#define DATALOG_BASE HISTORY_END
 #if defined(GC03)
 #define DATALOG_SIZE (FLASH_END_ - DATALOG_BASE - FLASH_PAGE_SIZE)
 #else
@@ -39,4 +49,11 @@ const uint8_t *readFlash(uint32_t source, uint32_t count);
 bool writeFlash(uint32_t dest, const uint8_t *source, uint32_t count);
 bool eraseFlash(uint32_t dest);
 
+bool isFlashEmpty(uint32_t address, uint32_t count);
+
+void requestFlashErase(uint32_t pageBase);
+void completeFlashErase(uint32_t pageBase);
+
+void updateFlash(void);
+
 #endif
@@ -183,18 +183,19 @@ static const char *onRTCOptionMenuGetOption(menu_size_t index, MenuStyle *menuSt
 
     if (index < itemCount)
     {
-        strclr(menuOption);
+        StrBuf optionBuffer;
+        initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
 
         if ((rtcMenuState.selectedIndex == DATETIME_HOUR) &&
             (settings.rtcTimeFormat == RTC_TIMEFORMAT_12_HOUR))
         {
             uint32_t hour = index % 12;
-            strcatUInt32(menuOption, (hour == 0) ? 12 : hour, 1);
-            strcatChar(menuOption, ' ');
-            strcat(menuOption, index < 12 ? getString(STRING_AM) : getString(STRING_PM));
+            strbufUInt32(&optionBuffer, (hour == 0) ? 12 : hour, 1);
+            strbufChar(&optionBuffer, ' ');
+            strbufString(&optionBuffer, index < 12 ? getString(STRING_AM) : getString(STRING_PM));
         }
         else
-            strcatUInt32(menuOption, rtcMenuOptionSetting->offset + index, 0);
+            strbufUInt32(&optionBuffer, rtcMenuOptionSetting->offset + index, 0);
 
         return menuOption;
     }
@@ -253,16 +254,19 @@ static const char *onRTCTimeZoneMenuGetOption(menu_size_t index, MenuStyle *menu
 
     int32_t deltaTimeMinutes = 60 * (index - RTC_TIMEZONE_P0000);
 
+    StrBuf optionBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+
     if (deltaTimeMinutes < 0)
     {
-        strcpy(menuOption, getString(STRING_UTCMINUS));
+        strbufString(&optionBuffer, getString(STRING_UTCMINUS));
 
         deltaTimeMinutes = -deltaTimeMinutes;
     }
     else
-        strcpy(menuOption, getString(STRING_UTCPLUS));
+        strbufString(&optionBuffer, getString(STRING_UTCPLUS));
 
-    strcatTime(menuOption, deltaTimeMinutes);
+    strbufTime(&optionBuffer, deltaTimeMinutes);
 
     return menuOption;
 }
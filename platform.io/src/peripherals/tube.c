@@ -70,6 +70,16 @@ static void showHVCustomProfileMenu(void);
 static void showHVProfilesMenu(void);
 #endif
 
+static struct
+{
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t lostNum;
+    uint32_t previousLostNum;
+
+    volatile uint32_t buffer[TUBE_PULSE_TIMESTAMP_NUM];
+} tubePulseTimestamps;
+
 volatile uint32_t tubePulseCount;
 volatile uint32_t tubeRandomBits;
 volatile uint32_t tubeDeadTime;
@@ -103,6 +113,45 @@ void resetTube(void)
 #endif
 }
 
+// Pulse timestamps
+
+void pushTubePulseTimestamp(uint32_t timestamp)
+{
+    uint32_t head = tubePulseTimestamps.head;
+
+    if ((head - tubePulseTimestamps.tail) >= TUBE_PULSE_TIMESTAMP_NUM)
+    {
+        tubePulseTimestamps.lostNum++;
+
+        return;
+    }
+
+    tubePulseTimestamps.buffer[head % TUBE_PULSE_TIMESTAMP_NUM] = timestamp;
+    tubePulseTimestamps.head = head + 1;
+}
+
+bool popTubePulseTimestamp(uint32_t *timestamp)
+{
+    uint32_t tail = tubePulseTimestamps.tail;
+
+    if (tail == tubePulseTimestamps.head)
+        return false;
+
+    *timestamp = tubePulseTimestamps.buffer[tail % TUBE_PULSE_TIMESTAMP_NUM];
+    tubePulseTimestamps.tail = tail + 1;
+
+    return true;
+}
+
+uint32_t getTubePulseTimestampLostNum(void)
+{
+    uint32_t lostNum = tubePulseTimestamps.lostNum;
+    uint32_t value = lostNum - tubePulseTimestamps.previousLostNum;
+    tubePulseTimestamps.previousLostNum = lostNum;
+
+    return value;
+}
+
 // Tube sensitivity
 
 static uint32_t getTubeIndex()
@@ -364,10 +413,11 @@ static const char *onTubeSensitivityMenuGetOption(menu_size_t index, MenuStyle *
     if (index == 0)
         return getString(STRING_TUBE_DEFAULT);
 
-    strclr(menuOption);
-    strcatFloat(menuOption, getTubeSensitivityForIndex(index), 2);
-    strcatChar(menuOption, ' ');
-    strcat(menuOption, getString(STRING_CPMUSVH));
+    StrBuf optionBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    strbufFloat(&optionBuffer, getTubeSensitivityForIndex(index), 2);
+    strbufChar(&optionBuffer, ' ');
+    strbufString(&optionBuffer, getString(STRING_CPMUSVH));
 
     return menuOption;
 }
@@ -399,10 +449,11 @@ static const char *onTubeDeadTimeCompensationMenuGetOption(menu_size_t index, Me
     if (index == 0)
         return getString(STRING_OFF);
 
-    strclr(menuOption);
-    strcatFloat(menuOption, 1000000.0F * getTubeDeadTimeCompensationForIndex(index), 2);
-    strcatChar(menuOption, ' ');
-    strcat(menuOption, getString(STRING_MICROSECONDS));
+    StrBuf optionBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    strbufFloat(&optionBuffer, 1000000.0F * getTubeDeadTimeCompensationForIndex(index), 2);
+    strbufChar(&optionBuffer, ' ');
+    strbufString(&optionBuffer, getString(STRING_MICROSECONDS));
 
     return menuOption;
 }
@@ -431,10 +482,11 @@ static const char *onHVFrequencyMenuGetOption(menu_size_t index, MenuStyle *menu
 {
     *menuStyle = (index == settings.tubeHVFrequency);
 
-    strclr(menuOption);
-    strcatFloat(menuOption, getTubeHVFrequencyForIndex(index) / 1000.0F, 2);
-    strcatChar(menuOption, ' ');
-    strcat(menuOption, getString(STRING_KHZ));
+    StrBuf optionBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    strbufFloat(&optionBuffer, getTubeHVFrequencyForIndex(index) / 1000.0F, 2);
+    strbufChar(&optionBuffer, ' ');
+    strbufString(&optionBuffer, getString(STRING_KHZ));
 
     return menuOption;
 }
@@ -461,9 +513,10 @@ static const char *onHVDutyCycleMenuGetOption(menu_size_t index, MenuStyle *menu
 {
     *menuStyle = (index == settings.tubeHVDutyCycle);
 
-    strclr(menuOption);
-    strcatFloat(menuOption, 100.0F * getTubeHVDutyCycleForIndex(index), 2);
-    strcat(menuOption, STRING_PERCENT);
+    StrBuf optionBuffer;
+    initStrBuf(&optionBuffer, menuOption, MENU_OPTION_STRING_SIZE);
+    strbufFloat(&optionBuffer, 100.0F * getTubeHVDutyCycleForIndex(index), 2);
+    strbufString(&optionBuffer, STRING_PERCENT);
 
     return menuOption;
 }
@@ -15,6 +15,8 @@
 
 #include "../ui/menu.h"
 
+#define TUBE_PULSE_TIMESTAMP_NUM 64
+
 extern const Menu sourceCompensationMenu;
 
 extern volatile uint32_t tubePulseCount;
@@ -46,6 +48,10 @@ void updateTubeHV(void);
 void onTubeTick(void);
 bool readTubeDet(void);
 
+void pushTubePulseTimestamp(uint32_t timestamp);
+bool popTubePulseTimestamp(uint32_t *timestamp);
+uint32_t getTubePulseTimestampLostNum(void);
+
 void showTubeMenu(void);
 
 #endif
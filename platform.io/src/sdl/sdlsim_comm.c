@@ -95,33 +95,14 @@ void pollComm(void)
     if (!comm.open)
         return;
 
+    // Requests are queued while responses are sent
+    for (int32_t i = 0;
+         i < receivedBytes;
+         i++)
+        receiveComm(receiveBuffer[i]);
+
     switch (comm.state)
     {
-    case COMM_RX:
-        for (int32_t i = 0;
-             i < receivedBytes;
-             i++)
-        {
-            char c = receiveBuffer[i];
-
-            if ((c >= ' ') &&
-                (comm.bufferIndex < (COMM_BUFFER_SIZE - 1)))
-                comm.buffer[comm.bufferIndex++] = c;
-            else if ((c == '\r') ||
-                     ((c == '\n') &&
-                      (comm.previousChar != '\r')))
-            {
-                comm.buffer[comm.bufferIndex] = '\0';
-
-                comm.bufferIndex = 0;
-                comm.state = COMM_RX_READY;
-            }
-
-            comm.previousChar = c;
-        }
-
-        break;
-
     case COMM_TX:
     {
         char *sendBuffer = comm.buffer + comm.bufferIndex;
@@ -147,6 +128,9 @@ void pollComm(void)
 
         break;
     }
+
+    default:
+        break;
     }
 }
 
@@ -12,6 +12,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <SDL.h>
 
@@ -19,7 +20,9 @@
 #include <mcu-renderer-st7789.h>
 
 #include "../measurements/datalog.h"
+#include "../measurements/history.h"
 #include "../peripherals/display.h"
+#include "../sdl/sdlsim_pulsetrain.h"
 #include "../system/cstring.h"
 #include "../system/events.h"
 #include "../system/settings.h"
@@ -36,26 +39,83 @@ static bool vibratorEnabled;
 static bool greenLEDOn;
 static bool redLEDOn;
 
+// Simulation speed: RADPRO_SIM_SPEED sets the simulated time per real time
+// (default 1; 0 runs as fast as possible)
+
+#define SIM_FRAME_TIME_MAX 50
+#define SIM_FRAME_TIME_CHECK_TICKS 1024
+
+static struct
+{
+    uint32_t speed;
+    uint32_t previousSDLTicks;
+    uint32_t frameTickNum;
+} simulation;
+
 static const uint8_t displayBrightnessValues[] = {
     0x3f, 0x7f, 0xbf, 0xff};
 
-#if defined(ST7789_DEBUG)
+static mr_t mr_sdl;
+
+#if defined(DISPLAY_COLOR)
+
+// SPI bus accounting: RADPRO_SIM_SPI_CLOCK routes drawing through the
+// ST7789 driver at the given SPI clock (Hz) and decodes its bus traffic.
+// RADPRO_SIM_SPI_LOG optionally writes one CSV row per drawn frame.
+
+#define SPI_VIEW_NUM 32
+
+typedef struct
+{
+    uint64_t byteNum;
+    uint64_t windowNum;
+    uint64_t pixelNum;
+    uint64_t overdrawPixelNum;
+} SPITraffic;
+
+typedef struct
+{
+    const char *name;
+    uint32_t frameNum;
+    SPITraffic traffic;
+} SPIView;
+
+static uint8_t textbuffer[88 * 88];
+
+static struct
+{
+    uint32_t index;
+    bool command;
+    uint8_t instruction;
+
+    uint32_t x0;
+    uint32_t x1;
+    uint32_t y0;
+    uint32_t y1;
 
-mr_t mr_sdl;
-char textbuffer[88 * 88];
-uint32_t st7789Index;
-bool st7789Command;
-uint8_t st7789Instruction;
+    uint32_t x;
+    uint32_t y;
+} st7789;
 
-uint32_t st7789x0;
-uint32_t st7789x1;
-uint32_t st7789y0;
-uint32_t st7789y1;
+static struct
+{
+    uint32_t clock;
+    FILE *logFile;
+
+    uint32_t frameIndex;
+    uint32_t *pixelFrameIndices;
+
+    const char *viewName;
+    SPITraffic frame;
+
+    const char *lastViewName;
+    SPITraffic lastFrame;
 
-uint32_t st7789x;
-uint32_t st7789y;
+    SPIView views[SPI_VIEW_NUM];
+    uint32_t viewNum;
+} spi;
 
-void onSleep(uint32_t value)
+static void onSleep(uint32_t value)
 {
 }
 
@@ -69,82 +129,241 @@ static void onChipSelect(bool value)
 
 static void onCommand(bool value)
 {
-    if (st7789Command != value)
-        st7789Index = 0;
+    if (st7789.command != value)
+        st7789.index = 0;
 
-    st7789Command = value;
+    st7789.command = value;
 }
 
-static void onSend(uint16_t value)
+static void writeST7789Pixel(uint16_t value)
+{
+    uint32_t index = st7789.y * mr_sdl.display_width + st7789.x;
+
+    if ((st7789.x < (uint32_t)mr_sdl.display_width) &&
+        (st7789.y < (uint32_t)mr_sdl.display_height))
+    {
+        mr_color_t *framebuffer = (mr_color_t *)mr_sdl.buffer;
+        framebuffer[index] = value;
+
+        // Pixels written more than once per frame
+        if (spi.pixelFrameIndices[index] == spi.frameIndex)
+            spi.frame.overdrawPixelNum++;
+        else
+            spi.pixelFrameIndices[index] = spi.frameIndex;
+    }
+
+    spi.frame.pixelNum++;
+
+    st7789.x += 1;
+    if (st7789.x > st7789.x1)
+    {
+        st7789.x = st7789.x0;
+        st7789.y += 1;
+    }
+}
+
+static void decodeST7789(uint16_t value)
 {
-    if (st7789Command)
+    if (st7789.command)
     {
-        if (st7789Index == 0)
-            st7789Instruction = value;
+        if (st7789.index == 0)
+            st7789.instruction = value;
 
-        switch (st7789Instruction)
+        switch (st7789.instruction)
         {
+        case MR_ST7789_CASET:
+            spi.frame.windowNum++;
+
+            break;
+
         case MR_ST7789_RAMWR:
-            st7789x = st7789x0;
-            st7789y = st7789y0;
+            st7789.x = st7789.x0;
+            st7789.y = st7789.y0;
 
             break;
         }
     }
     else
     {
-        switch (st7789Instruction)
+        switch (st7789.instruction)
         {
         case MR_ST7789_CASET:
-            if (st7789Index == 0)
-                st7789x0 = (st7789x0 & ~0xff00) | (value << 8);
-            else if (st7789Index == 1)
-                st7789x0 = (st7789x0 & ~0x00ff) | (value << 0);
-            else if (st7789Index == 2)
-                st7789x1 = (st7789x1 & ~0xff00) | (value << 8);
-            else if (st7789Index == 3)
-                st7789x1 = (st7789x1 & ~0x00ff) | (value << 0);
+            if (st7789.index == 0)
+                st7789.x0 = (st7789.x0 & ~0xff00) | (value << 8);
+            else if (st7789.index == 1)
+                st7789.x0 = (st7789.x0 & ~0x00ff) | (value << 0);
+            else if (st7789.index == 2)
+                st7789.x1 = (st7789.x1 & ~0xff00) | (value << 8);
+            else if (st7789.index == 3)
+                st7789.x1 = (st7789.x1 & ~0x00ff) | (value << 0);
 
             break;
 
         case MR_ST7789_RASET:
-            if (st7789Index == 0)
-                st7789y0 = (st7789y0 & ~0xff00) | (value << 8);
-            else if (st7789Index == 1)
-                st7789y0 = (st7789y0 & ~0x00ff) | (value << 0);
-            else if (st7789Index == 2)
-                st7789y1 = (st7789y1 & ~0xff00) | (value << 8);
-            else if (st7789Index == 3)
-                st7789y1 = (st7789y1 & ~0x00ff) | (value << 0);
+            if (st7789.index == 0)
+                st7789.y0 = (st7789.y0 & ~0xff00) | (value << 8);
+            else if (st7789.index == 1)
+                st7789.y0 = (st7789.y0 & ~0x00ff) | (value << 0);
+            else if (st7789.index == 2)
+                st7789.y1 = (st7789.y1 & ~0xff00) | (value << 8);
+            else if (st7789.index == 3)
+                st7789.y1 = (st7789.y1 & ~0x00ff) | (value << 0);
 
             break;
 
         case MR_ST7789_RAMWR:
-        {
-            mr_color_t *framebuffer = (mr_color_t *)mr_sdl.buffer;
-            framebuffer[st7789y * mr_sdl.display_width + st7789x] = value;
-            st7789x += 1;
-            if (st7789x > st7789x1)
-            {
-                st7789x = st7789x0;
-                st7789y += 1;
-            }
+            writeST7789Pixel(value);
 
             break;
         }
-        }
 
-        st7789Index++;
+        st7789.index++;
+    }
+}
+
+static void onSend(uint16_t value)
+{
+    spi.frame.byteNum += 1;
+
+    decodeST7789(value);
+}
+
+static void onSend16(uint16_t value)
+{
+    spi.frame.byteNum += 2;
+
+    decodeST7789(value);
+}
+
+static double getSPIBusTime(const SPITraffic *traffic)
+{
+    return 8.0 * traffic->byteNum / spi.clock;
+}
+
+static void addSPITraffic(SPITraffic *traffic, const SPITraffic *frame)
+{
+    traffic->byteNum += frame->byteNum;
+    traffic->windowNum += frame->windowNum;
+    traffic->pixelNum += frame->pixelNum;
+    traffic->overdrawPixelNum += frame->overdrawPixelNum;
+}
+
+static SPIView *getSPIView(const char *name)
+{
+    for (uint32_t i = 0; i < spi.viewNum; i++)
+        if (!strcmp(spi.views[i].name, name))
+            return &spi.views[i];
+
+    if (spi.viewNum >= SPI_VIEW_NUM)
+        return NULL;
+
+    SPIView *view = &spi.views[spi.viewNum++];
+    view->name = name;
+
+    return view;
+}
+
+static void initSPIAccounting(void)
+{
+    const char *clockValue = getenv("RADPRO_SIM_SPI_CLOCK");
+    spi.clock = clockValue ? (uint32_t)strtoul(clockValue, NULL, 10) : 0;
+    if (!spi.clock)
+        return;
+
+    spi.frameIndex = 1;
+    spi.pixelFrameIndices = calloc(DISPLAY_WIDTH * DISPLAY_HEIGHT,
+                                   sizeof(uint32_t));
+
+    const char *logPath = getenv("RADPRO_SIM_SPI_LOG");
+    if (logPath)
+    {
+        spi.logFile = fopen(logPath, "w");
+        if (!spi.logFile)
+            fprintf(stderr, "Could not open %s\n", logPath);
+        else
+            fprintf(spi.logFile, "tick,view,bytes,windows,pixels,overdraw_pixels,bus_time_us\n");
     }
 }
 
-#else
+static void printSPIViews(void)
+{
+    if (!spi.clock)
+        return;
+
+    printf("%-24s %8s %12s %10s %10s %12s\n",
+           "View",
+           "Frames",
+           "Bytes/frame",
+           "Windows",
+           "Overdraw",
+           "Bus time/ms");
+
+    for (uint32_t i = 0; i < spi.viewNum; i++)
+    {
+        const SPIView *view = &spi.views[i];
+        const SPITraffic *traffic = &view->traffic;
+        double frameNum = view->frameNum;
+
+        printf("%-24s %8u %12.0f %10.1f %9.1f%% %12.2f\n",
+               view->name,
+               view->frameNum,
+               traffic->byteNum / frameNum,
+               traffic->windowNum / frameNum,
+               traffic->pixelNum
+                   ? 100.0 * traffic->overdrawPixelNum / traffic->pixelNum
+                   : 0.0,
+               1000.0 * getSPIBusTime(traffic) / frameNum);
+    }
 
-#define mr_sdl mr
+    if (spi.logFile)
+        fclose(spi.logFile);
+}
+
+#endif
 
+void setDisplayViewName(const char *name)
+{
+#if defined(DISPLAY_COLOR)
+    spi.viewName = name;
 #endif
+}
+
+void onDisplayFrame(void)
+{
+#if defined(DISPLAY_COLOR)
+    if (!spi.clock)
+        return;
 
-extern float tubeCPS;
+    const char *viewName = spi.viewName ? spi.viewName : "-";
+
+    SPIView *view = getSPIView(viewName);
+    if (view)
+    {
+        view->frameNum++;
+        addSPITraffic(&view->traffic, &spi.frame);
+    }
+
+    if (spi.logFile)
+        fprintf(spi.logFile,
+                "%u,\"%s\",%llu,%llu,%llu,%llu,%.1f\n",
+                currentTick,
+                viewName,
+                (unsigned long long)spi.frame.byteNum,
+                (unsigned long long)spi.frame.windowNum,
+                (unsigned long long)spi.frame.pixelNum,
+                (unsigned long long)spi.frame.overdrawPixelNum,
+                1E6 * getSPIBusTime(&spi.frame));
+
+    spi.lastViewName = view ? view->name : NULL;
+    spi.lastFrame = spi.frame;
+
+    spi.viewName = NULL;
+    spi.frame = (SPITraffic){0};
+    spi.frameIndex++;
+
+    updateDisplayTitle();
+#endif
+}
 
 void initDisplay(void)
 {
@@ -158,27 +377,35 @@ void initDisplay(void)
                 FIRMWARE_NAME);
     mr_sdl = mr;
 #elif defined(DISPLAY_COLOR)
-#if defined(ST7789_DEBUG)
-    mr_st7789_init(&mr,
-                   DISPLAY_HEIGHT,
-                   DISPLAY_WIDTH,
-                   MR_DISPLAY_ROTATION_270,
-                   &textbuffer,
-                   sizeof(textbuffer),
-                   onSleep,
-                   onSetReset,
-                   onChipSelect,
-                   onCommand,
-                   onSend,
-                   onSend);
-#endif
     mr_sdl_init(&mr_sdl,
                 DISPLAY_WIDTH,
                 DISPLAY_HEIGHT,
                 MR_SDL_DISPLAY_TYPE_COLOR,
                 DISPLAY_UPSCALE,
                 FIRMWARE_NAME);
+
+    initSPIAccounting();
+    if (spi.clock)
+        mr_st7789_init(&mr,
+                       DISPLAY_HEIGHT,
+                       DISPLAY_WIDTH,
+                       MR_DISPLAY_ROTATION_270,
+                       textbuffer,
+                       sizeof(textbuffer),
+                       onSleep,
+                       onSetReset,
+                       onChipSelect,
+                       onCommand,
+                       onSend,
+                       onSend16);
+    else
+        mr = mr_sdl;
 #endif
+
+    const char *speedValue = getenv("RADPRO_SIM_SPEED");
+    simulation.speed = speedValue ? (uint32_t)strtoul(speedValue, NULL, 10) : 1;
+    simulation.previousSDLTicks = SDL_GetTicks();
+
     updateDisplayTitle();
 }
 
@@ -212,7 +439,12 @@ void updateDisplay(void)
         switch (event.type)
         {
         case SDL_QUIT:
+#if defined(DISPLAY_COLOR)
+            printSPIViews();
+#endif
+
             stopDatalog();
+            saveHistory();
             saveSettings();
 
             exit(0);
@@ -221,6 +453,10 @@ void updateDisplay(void)
 
         case SDL_KEYDOWN:
         {
+            if (!isPulseTrainRateAdjustable())
+                break;
+
+            float tubeCPS = getPulseTrainRate();
             float tubeCPSAdjustment = expf(logf(10) / 20);
 
             if (event.key.keysym.mod & KMOD_LCTRL)
@@ -233,6 +469,9 @@ void updateDisplay(void)
             else if (tubeCPS > 100000.0F)
                 tubeCPS = 100000.0F;
 
+            if (tubeCPS != getPulseTrainRate())
+                setPulseTrainRate(tubeCPS);
+
             updateDisplayTitle();
 
             break;
@@ -241,16 +480,54 @@ void updateDisplay(void)
     }
 }
 
+static void startSimulationFrame(void)
+{
+    uint32_t sdlTicks = SDL_GetTicks();
+    uint32_t elapsedTime = sdlTicks - simulation.previousSDLTicks;
+
+    simulation.previousSDLTicks = sdlTicks;
+
+    if (elapsedTime > SIM_FRAME_TIME_MAX)
+        elapsedTime = SIM_FRAME_TIME_MAX;
+
+    simulation.frameTickNum = simulation.speed
+                                  ? elapsedTime * simulation.speed
+                                  : UINT32_MAX;
+}
+
+static bool isSimulationFrameTimeElapsed(void)
+{
+    // Maximum speed: run for a frame time, then refresh the display
+    return !simulation.speed &&
+           !(simulation.frameTickNum % SIM_FRAME_TIME_CHECK_TICKS) &&
+           ((SDL_GetTicks() - simulation.previousSDLTicks) >= SIM_FRAME_TIME_MAX);
+}
+
 bool onSDLTick(void)
 {
-    int32_t deltaTicks = SDL_GetTicks() - currentTick;
+    if (!simulation.frameTickNum)
+    {
+        startSimulationFrame();
+
+        if (!simulation.frameTickNum)
+        {
+            updateDisplay();
+
+            return false;
+        }
+    }
 
     currentTick++;
 
     onTick();
 
-    if (deltaTicks < 0)
+    simulation.frameTickNum--;
+
+    if (!simulation.frameTickNum ||
+        isSimulationFrameTimeElapsed())
     {
+        simulation.frameTickNum = 0;
+
         updateDisplay();
 
         return false;
@@ -263,7 +540,19 @@ static void updateDisplayTitle(void)
 {
     char buffer[256];
 
-    sprintf(buffer, "%s (%.2f cps)", FIRMWARE_NAME, tubeCPS);
+    if (isPulseTrainRateAdjustable())
+        sprintf(buffer, "%s (%.2f cps)", FIRMWARE_NAME, getPulseTrainRate());
+    else
+        sprintf(buffer, "%s (replay)", FIRMWARE_NAME);
+    if (simulation.speed != 1)
+    {
+        strcat(buffer, " ");
+        if (simulation.speed)
+            strcatUInt32(buffer, simulation.speed, 0);
+        else
+            strcat(buffer, "max");
+        strcat(buffer, "x");
+    }
 
     if (vibratorEnabled || greenLEDOn || redLEDOn)
     {
@@ -279,6 +568,23 @@ static void updateDisplayTitle(void)
             strcat(buffer, "🟥");
     }
 
+#if defined(DISPLAY_COLOR)
+    if (spi.clock && spi.lastViewName)
+    {
+        const SPITraffic *traffic = &spi.lastFrame;
+
+        sprintf(buffer + strlen(buffer),
+                " | %s: %llu B, %llu windows, %.0f%% overdraw, %.2f ms",
+                spi.lastViewName,
+                (unsigned long long)traffic->byteNum,
+                (unsigned long long)traffic->windowNum,
+                traffic->pixelNum
+                    ? 100.0 * traffic->overdrawPixelNum / traffic->pixelNum
+                    : 0.0,
+                1000.0 * getSPIBusTime(traffic));
+    }
+#endif
+
     mr_sdl_set_title(&mr_sdl, buffer);
 }
 
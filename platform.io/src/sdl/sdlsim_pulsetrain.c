@@ -0,0 +1,314 @@
+/*
+ * Rad Pro
+ * Simulator pulse train
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if defined(SIMULATOR)
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../peripherals/tube.h"
+#include "../sdl/sdlsim_pulsetrain.h"
+#include "../system/events.h"
+
+#define PULSE_TICKS_PER_SYSTICK (PULSE_MEASUREMENT_FREQUENCY / SYSTICK_FREQUENCY)
+
+#define PULSETRAIN_REPLAY_BUFFER_SIZE 1024
+#define PULSETRAIN_PULSETIME_NONE UINT64_MAX
+
+typedef enum
+{
+    PULSETRAIN_POISSON,
+    PULSETRAIN_RATEPROFILE,
+    PULSETRAIN_REPLAY,
+} PulseTrainMode;
+
+typedef struct
+{
+    uint64_t time;
+    float cps;
+} RateProfileStep;
+
+static struct
+{
+    PulseTrainMode mode;
+
+    uint32_t randomState;
+
+    // currentTick wraps after 2^32 ticks
+    uint64_t tick;
+    uint64_t time;
+    uint64_t nextPulseTime;
+    float cps;
+
+    RateProfileStep *rateProfile;
+    uint32_t rateProfileStepNum;
+    uint32_t rateProfileIndex;
+
+    FILE *replayFile;
+    uint32_t replayFrequency;
+    uint64_t replayClockTime;
+    uint64_t replayStartTime;
+    uint32_t replayBufferIndex;
+    uint32_t replayBufferSize;
+    uint8_t replayBuffer[4 * PULSETRAIN_REPLAY_BUFFER_SIZE];
+} pulseTrain;
+
+// Random numbers
+
+static uint32_t getRandomUInt32(void)
+{
+    // xorshift32: identical on every host C library
+    uint32_t x = pulseTrain.randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pulseTrain.randomState = x;
+
+    return x;
+}
+
+static float getUniformRandomValue(void)
+{
+    // (0, 1]
+    return ((getRandomUInt32() >> 8) + 1) * (1.0F / 16777216.0F);
+}
+
+// Poisson process
+
+static void schedulePoissonPulse(uint64_t time)
+{
+    if (pulseTrain.cps <= 0)
+    {
+        pulseTrain.nextPulseTime = PULSETRAIN_PULSETIME_NONE;
+
+        return;
+    }
+
+    float meanPulseInterval = PULSE_MEASUREMENT_FREQUENCY / pulseTrain.cps;
+
+    pulseTrain.nextPulseTime = time +
+                               (uint64_t)(-logf(getUniformRandomValue()) * meanPulseInterval) +
+                               1;
+}
+
+// Rate profile
+
+static bool loadRateProfile(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    if (!fp)
+    {
+        printf("Could not open rate profile: %s\n", path);
+
+        return false;
+    }
+
+    float time;
+    float cps;
+    while (fscanf(fp, "%f %f", &time, &cps) == 2)
+    {
+        RateProfileStep *rateProfile = realloc(pulseTrain.rateProfile,
+                                               (pulseTrain.rateProfileStepNum + 1) * sizeof(RateProfileStep));
+        if (!rateProfile)
+            break;
+
+        pulseTrain.rateProfile = rateProfile;
+        pulseTrain.rateProfile[pulseTrain.rateProfileStepNum++] = (RateProfileStep){
+            (uint64_t)(time * PULSE_MEASUREMENT_FREQUENCY),
+            cps,
+        };
+    }
+
+    fclose(fp);
+
+    if (!pulseTrain.rateProfileStepNum)
+    {
+        printf("Rate profile is empty: %s\n", path);
+
+        return false;
+    }
+
+    pulseTrain.cps = 0;
+
+    return true;
+}
+
+static void updateRateProfile(void)
+{
+    // Steps are relative to the start of the simulation
+    bool rateChanged = false;
+
+    while ((pulseTrain.rateProfileIndex < pulseTrain.rateProfileStepNum) &&
+           (pulseTrain.rateProfile[pulseTrain.rateProfileIndex].time <= pulseTrain.time))
+    {
+        pulseTrain.cps = pulseTrain.rateProfile[pulseTrain.rateProfileIndex].cps;
+        pulseTrain.rateProfileIndex++;
+
+        rateChanged = true;
+    }
+
+    // Exact for piecewise-constant rates, as the process is memoryless
+    if (rateChanged)
+        schedulePoissonPulse(pulseTrain.time);
+}
+
+// Replay
+
+static bool readReplayInterval(uint32_t *interval)
+{
+    if (pulseTrain.replayBufferIndex >= pulseTrain.replayBufferSize)
+    {
+        size_t readSize = fread(pulseTrain.replayBuffer, 4, PULSETRAIN_REPLAY_BUFFER_SIZE, pulseTrain.replayFile);
+        if (!readSize)
+        {
+            // Loop
+            rewind(pulseTrain.replayFile);
+
+            readSize = fread(pulseTrain.replayBuffer, 4, PULSETRAIN_REPLAY_BUFFER_SIZE, pulseTrain.replayFile);
+            if (!readSize)
+                return false;
+        }
+
+        pulseTrain.replayBufferIndex = 0;
+        pulseTrain.replayBufferSize = (uint32_t)readSize;
+    }
+
+    const uint8_t *p = pulseTrain.replayBuffer + 4 * pulseTrain.replayBufferIndex++;
+    *interval = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | ((uint32_t)p[3] << 0);
+
+    return true;
+}
+
+static void scheduleReplayPulse(void)
+{
+    uint32_t interval;
+    if (!readReplayInterval(&interval))
+    {
+        pulseTrain.nextPulseTime = PULSETRAIN_PULSETIME_NONE;
+
+        return;
+    }
+
+    pulseTrain.replayClockTime += interval;
+
+    uint64_t seconds = pulseTrain.replayClockTime / pulseTrain.replayFrequency;
+    uint64_t remainder = pulseTrain.replayClockTime % pulseTrain.replayFrequency;
+
+    pulseTrain.nextPulseTime = pulseTrain.replayStartTime +
+                               seconds * PULSE_MEASUREMENT_FREQUENCY +
+                               remainder * PULSE_MEASUREMENT_FREQUENCY / pulseTrain.replayFrequency;
+}
+
+static bool openReplay(const char *path)
+{
+    pulseTrain.replayFile = fopen(path, "rb");
+    if (!pulseTrain.replayFile)
+    {
+        printf("Could not open pulse interval file: %s\n", path);
+
+        return false;
+    }
+
+    const char *frequencyValue = getenv("RADPRO_SIM_PULSES_FREQUENCY");
+    pulseTrain.replayFrequency = frequencyValue ? (uint32_t)strtoul(frequencyValue, NULL, 10) : 0;
+    if (!pulseTrain.replayFrequency)
+        pulseTrain.replayFrequency = PULSE_MEASUREMENT_FREQUENCY;
+
+    pulseTrain.replayStartTime = pulseTrain.time;
+
+    return true;
+}
+
+// Pulse train
+
+void initPulseTrain(uint32_t defaultSeed)
+{
+    const char *seedValue = getenv("RADPRO_SIM_SEED");
+    pulseTrain.randomState = seedValue ? (uint32_t)strtoul(seedValue, NULL, 0) : defaultSeed;
+    if (!pulseTrain.randomState)
+        pulseTrain.randomState = 1;
+
+    pulseTrain.tick = currentTick;
+    pulseTrain.time = pulseTrain.tick * PULSE_TICKS_PER_SYSTICK;
+    pulseTrain.nextPulseTime = PULSETRAIN_PULSETIME_NONE;
+
+    const char *replayPath = getenv("RADPRO_SIM_PULSES");
+    const char *rateProfilePath = getenv("RADPRO_SIM_RATEPROFILE");
+
+    if (replayPath && openReplay(replayPath))
+    {
+        pulseTrain.mode = PULSETRAIN_REPLAY;
+
+        scheduleReplayPulse();
+    }
+    else if (rateProfilePath && loadRateProfile(rateProfilePath))
+    {
+        pulseTrain.mode = PULSETRAIN_RATEPROFILE;
+
+        updateRateProfile();
+    }
+    else
+        pulseTrain.mode = PULSETRAIN_POISSON;
+}
+
+bool isPulseTrainRateAdjustable(void)
+{
+    return pulseTrain.mode == PULSETRAIN_POISSON;
+}
+
+void setPulseTrainRate(float value)
+{
+    if (pulseTrain.mode != PULSETRAIN_POISSON)
+        return;
+
+    pulseTrain.cps = value;
+
+    schedulePoissonPulse(pulseTrain.time);
+}
+
+float getPulseTrainRate(void)
+{
+    return pulseTrain.cps;
+}
+
+void onPulseTrainTick(void)
+{
+    if (pulseTrain.mode == PULSETRAIN_RATEPROFILE)
+        updateRateProfile();
+
+    pulseTrain.tick++;
+
+    uint64_t tickEndTime = pulseTrain.tick * PULSE_TICKS_PER_SYSTICK;
+
+    while (pulseTrain.nextPulseTime < tickEndTime)
+    {
+        uint64_t pulseTime = pulseTrain.nextPulseTime;
+
+        tubePulseCount++;
+        tubeRandomBits = (tubeRandomBits << 1) | (getRandomUInt32() >> 31);
+        pushTubePulseTimestamp((uint32_t)pulseTime);
+
+        if (pulseTrain.mode == PULSETRAIN_REPLAY)
+        {
+            scheduleReplayPulse();
+
+            // Recorded intervals carry the real tube dead time
+            uint64_t pulseInterval = pulseTrain.nextPulseTime - pulseTime;
+            if (pulseInterval < tubeDeadTime)
+                tubeDeadTime = (uint32_t)pulseInterval;
+        }
+        else
+            schedulePoissonPulse(pulseTime);
+    }
+
+    pulseTrain.time = tickEndTime;
+}
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Rad Pro
+ * Simulator pulse train
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if !defined(SDLSIM_PULSETRAIN_H)
+#define SDLSIM_PULSETRAIN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The pulse source is selected with environment variables:
+//
+// * RADPRO_SIM_PULSES: replay a pulse interval file (32-bit big-endian
+//   intervals, as written by radpro-tool --log-pulseintervals or
+//   tests/hh614-pulseinterval-capture.py). The file is looped.
+// * RADPRO_SIM_PULSES_FREQUENCY: clock frequency of the pulse interval
+//   file in Hz (default 1000000; use 8000000 for the HH614 capture).
+// * RADPRO_SIM_RATEPROFILE: text file with one "<time [s]> <rate [cps]>"
+//   line per rate step, generating Poisson pulses at each step's rate.
+// * RADPRO_SIM_SEED: random seed, for reproducible runs.
+//
+// Otherwise Poisson pulses are generated at the rate set with
+// setPulseTrainRate().
+
+void initPulseTrain(uint32_t defaultSeed);
+
+bool isPulseTrainRateAdjustable(void);
+void setPulseTrainRate(float value);
+float getPulseTrainRate(void);
+
+void onPulseTrainTick(void);
+
+#endif
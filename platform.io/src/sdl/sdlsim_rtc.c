@@ -13,16 +13,32 @@
 #include <time.h>
 
 #include "../peripherals/rtc.h"
+#include "../system/events.h"
 
+static uint32_t startTime;
 static int32_t timeDelta;
 
+// currentTick wraps after 2^32 ticks
+static uint32_t lastTick;
+static uint64_t tick;
+
 void initRTC(void)
 {
 }
 
 static uint32_t getLocalTime(void)
 {
-    return time(NULL);
+    // Extends currentTick to 64 bits; the time is read far more often
+    // than once per wrap
+    tick += (uint32_t)(currentTick - lastTick);
+    lastTick = currentTick;
+
+    // Follows simulated ticks, so faster than real time simulations log
+    // at the simulated rate
+    if (!startTime)
+        startTime = (uint32_t)time(NULL) - (uint32_t)(tick / SYSTICK_FREQUENCY);
+
+    return startTime + (uint32_t)(tick / SYSTICK_FREQUENCY);
 }
 
 bool setDeviceTime(uint32_t value)
@@ -24,3 +24,9 @@
 #endif
 
 uint32_t prescalePWMParameters(uint32_t *period, uint32_t *onTime);
+
+#if defined(DISPLAY_SPI_DMA_CHANNEL)
+void initDisplayDMA(void);
+void sendDisplayBlock(const uint16_t *buffer, uint32_t count);
+void waitDisplayDMA(void);
+#endif
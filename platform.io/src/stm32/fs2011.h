@@ -126,3 +126,15 @@
 #define USART_APB_FREQUENCY APB1_FREQUENCY
 #define USART_IRQ USART2_IRQn
 #define USART_IRQ_HANDLER USART2_IRQHandler
+#define USART_TX_DMA DMA1
+#if defined(STM32F0)
+#define USART_TX_DMA_CHANNEL DMA1_Channel4
+#define USART_TX_DMA_CHANNEL_INDEX 4
+#define USART_TX_DMA_IRQ DMA1_Channel4_5_IRQn
+#define USART_TX_DMA_IRQ_HANDLER DMA1_Channel4_5_IRQHandler
+#elif defined(STM32F1)
+#define USART_TX_DMA_CHANNEL DMA1_Channel7
+#define USART_TX_DMA_CHANNEL_INDEX 7
+#define USART_TX_DMA_IRQ DMA1_Channel7_IRQn
+#define USART_TX_DMA_IRQ_HANDLER DMA1_Channel7_IRQHandler
+#endif
@@ -159,6 +159,9 @@ extern mr_t mr;
 static bool displayEnabled;
 
 static uint8_t displayFramebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT / 8];
+#if defined(DISPLAY_SHADOW_FRAMEBUFFER)
+static uint8_t displayShadowFramebuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT / 8];
+#endif
 
 static const uint8_t displayInitSequence[] = {
     MR_SEND_COMMAND(MR_ST7565_BIAS_1_9),
@@ -268,6 +271,9 @@ void initDisplay(void)
                    onDisplaySetChipselect,
                    onDisplaySetCommand,
                    onDisplaySend);
+#if defined(DISPLAY_SHADOW_FRAMEBUFFER)
+    mr_st7565_set_shadow_framebuffer(&mr, displayShadowFramebuffer);
+#endif
 
     mr_send_sequence(&mr, displayInitSequence);
 
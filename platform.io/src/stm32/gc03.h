@@ -79,6 +79,8 @@
 #define DISPLAY_SDA_PORT GPIOA
 #define DISPLAY_SDA_PIN 7
 #define DISPLAY_SPI SPI1
+#define DISPLAY_SPI_DMA DMA1
+#define DISPLAY_SPI_DMA_CHANNEL DMA1_Channel3
 #define DISPLAY_BACKLIGHT_PORT GPIOB
 #define DISPLAY_BACKLIGHT_PIN 13
 #define DISPLAY_BACKLIGHT_TIMER TIM1
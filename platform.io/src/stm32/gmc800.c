@@ -140,6 +140,7 @@ extern mr_t mr;
 static bool displayEnabled;
 
 static uint8_t displayTextbuffer[88 * 88];
+static uint16_t displayBlockbuffer[2 * 240];
 
 static const uint8_t displayInitSequence[] = {
     MR_SEND_COMMAND(MR_ST7789_INVON),
@@ -195,14 +196,14 @@ static void onDisplaySetReset(bool value)
 
 static void onDisplaySetChipselect(bool value)
 {
-    spi_wait_while_busy(DISPLAY_SPI);
+    waitDisplayDMA();
 
     gpio_modify(DISPLAY_CSX_PORT, DISPLAY_CSX_PIN, !value);
 }
 
 static void onDisplaySetCommand(bool value)
 {
-    spi_wait_while_busy(DISPLAY_SPI);
+    waitDisplayDMA();
 
     gpio_modify(DISPLAY_DCX_PORT, DISPLAY_DCX_PIN, !value);
 }
@@ -236,6 +237,9 @@ void initDisplay(void)
     spi_setup(DISPLAY_SPI);
     spi_enable(DISPLAY_SPI);
 
+    // DMA
+    initDisplayDMA();
+
     // mcu-renderer
     mr_st7789_init(&mr,
                    240,
@@ -253,6 +257,10 @@ void initDisplay(void)
                    onDisplaySetCommand,
                    onDisplaySend,
                    onDisplaySend16);
+    mr_st7789_set_send_block(&mr,
+                             sendDisplayBlock,
+                             displayBlockbuffer,
+                             sizeof(displayBlockbuffer));
 
     mr_send_sequence(&mr, displayInitSequence);
 
@@ -65,6 +65,8 @@
 #define DISPLAY_SDA_PORT GPIOA
 #define DISPLAY_SDA_PIN 7
 #define DISPLAY_SPI SPI1
+#define DISPLAY_SPI_DMA DMA1
+#define DISPLAY_SPI_DMA_CHANNEL DMA1_Channel3
 #define DISPLAY_BACKLIGHT_PORT GPIOB
 #define DISPLAY_BACKLIGHT_PIN 0
 #define DISPLAY_BACKLIGHT_TIMER TIM3
@@ -103,6 +105,11 @@
 #define USART_APB_FREQUENCY APB2_FREQUENCY
 #define USART_IRQ USART1_IRQn
 #define USART_IRQ_HANDLER USART1_IRQHandler
+#define USART_TX_DMA DMA1
+#define USART_TX_DMA_CHANNEL DMA1_Channel4
+#define USART_TX_DMA_CHANNEL_INDEX 4
+#define USART_TX_DMA_IRQ DMA1_Channel4_IRQn
+#define USART_TX_DMA_IRQ_HANDLER DMA1_Channel4_IRQHandler
 
 #define SYSTEM_RESET_EN_PORT GPIOC
 #define SYSTEM_RESET_EN_PIN 0
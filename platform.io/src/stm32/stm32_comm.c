@@ -20,6 +20,11 @@
 
 #if defined(USART_INTERFACE)
 
+#if defined(USART_TX_DMA_CHANNEL)
+static char commTransmitBuffer[COMM_BUFFER_SIZE];
+static volatile bool commTransmitActive;
+#endif
+
 void initCommHardware(void)
 {
 }
@@ -49,6 +54,16 @@ void openComm(void)
     NVIC_SetPriority(USART_IRQ, 0x40);
     NVIC_EnableIRQ(USART_IRQ);
 
+#if defined(USART_TX_DMA_CHANNEL)
+    // DMA
+    rcc_enable_dma(USART_TX_DMA);
+
+    usart_enable_transmit_dma(USART_INTERFACE);
+
+    NVIC_SetPriority(USART_TX_DMA_IRQ, 0x40);
+    NVIC_EnableIRQ(USART_TX_DMA_IRQ);
+#endif
+
     clearComm(true);
 }
 
@@ -63,6 +78,16 @@ void closeComm(void)
     usart_disable_receive_interrupt(USART_INTERFACE);
     usart_disable_transmit_interrupt(USART_INTERFACE);
 
+#if defined(USART_TX_DMA_CHANNEL)
+    // DMA
+    NVIC_DisableIRQ(USART_TX_DMA_IRQ);
+
+    dma_disable(USART_TX_DMA_CHANNEL);
+    usart_disable_transmit_dma(USART_INTERFACE);
+
+    commTransmitActive = false;
+#endif
+
     // GPIO
 #if defined(STM32F0) || defined(STM32G0) || defined(STM32L4)
     gpio_setup_analog(USART_RX_PORT, USART_RX_PIN, GPIO_PULL_FLOATING);
@@ -78,6 +103,61 @@ void closeComm(void)
     clearComm(false);
 }
 
+#if defined(USART_TX_DMA_CHANNEL)
+
+static void startCommTransmitDMA(void)
+{
+    // The chunk is copied out, so the next one can be prepared meanwhile
+    uint32_t size = strlen(comm.buffer);
+
+    memcpy(commTransmitBuffer, comm.buffer, size);
+
+    strclr(comm.buffer);
+    comm.bufferIndex = 0;
+
+    if (comm.transmitState == TRANSMIT_RESPONSE)
+        comm.state = COMM_RX;
+    else
+        comm.state = COMM_TX_READY;
+
+    commTransmitActive = (size != 0);
+    if (!commTransmitActive)
+        return;
+
+    dma_disable(USART_TX_DMA_CHANNEL);
+    dma_setup_memory8_to_peripheral8(USART_TX_DMA_CHANNEL,
+                                     usart_get_transmit_data_address(USART_INTERFACE),
+                                     (uint32_t)commTransmitBuffer,
+                                     size);
+    dma_enable_transfer_complete_interrupt(USART_TX_DMA_CHANNEL);
+    dma_enable(USART_TX_DMA_CHANNEL);
+}
+
+void transmitComm(void)
+{
+    NVIC_DisableIRQ(USART_TX_DMA_IRQ);
+
+    comm.state = COMM_TX;
+
+    // Otherwise sent when the previous chunk completes
+    if (!commTransmitActive)
+        startCommTransmitDMA();
+
+    NVIC_EnableIRQ(USART_TX_DMA_IRQ);
+}
+
+void USART_TX_DMA_IRQ_HANDLER(void)
+{
+    dma_clear_interrupt_flags(USART_TX_DMA, USART_TX_DMA_CHANNEL_INDEX);
+
+    commTransmitActive = false;
+
+    if (comm.state == COMM_TX)
+        startCommTransmitDMA();
+}
+
+#else
+
 void transmitComm(void)
 {
     comm.state = COMM_TX;
@@ -85,82 +165,42 @@ void transmitComm(void)
     usart_enable_transmit_interrupt(USART_INTERFACE);
 }
 
+#endif
+
 void USART_IRQ_HANDLER(void)
 {
-    int16_t c = -1;
-
+    // Requests are queued while responses are sent
     if (usart_is_receive_ready(USART_INTERFACE))
-        c = usart_receive(USART_INTERFACE);
+        receiveComm(usart_receive(USART_INTERFACE));
 
     if (usart_is_overrun(USART_INTERFACE))
     {
         usart_clear_overrun(USART_INTERFACE);
 
-        if (comm.state == COMM_RX)
-        {
-            // Invalidate command
-            comm.buffer[0] = ' ';
-            comm.bufferIndex = 1;
-        }
+        discardCommLine();
     }
 
-    switch (comm.state)
+#if !defined(USART_TX_DMA_CHANNEL)
+    if ((comm.state == COMM_TX) &&
+        usart_is_send_ready(USART_INTERFACE))
     {
-    case COMM_RX:
-        if ((c >= ' ') &&
-            (comm.bufferIndex < (COMM_BUFFER_SIZE - 1)))
-        {
-            comm.buffer[comm.bufferIndex++] = c;
-
-#if defined(GMC800)
-            if ((c == '>') && (comm.previousChar == '>'))
-            {
-                comm.buffer[comm.bufferIndex] = '\0';
-
-                comm.bufferIndex = 0;
-                comm.state = COMM_RX_READY;
-            }
-#endif
-        }
-        else if ((c == '\r') ||
-                 ((c == '\n') &&
-                  (comm.previousChar != '\r')))
+        char c = comm.buffer[comm.bufferIndex++];
+        if (c != '\0')
+            usart_send(USART_INTERFACE, c);
+        else
         {
-            comm.buffer[comm.bufferIndex] = '\0';
+            usart_disable_transmit_interrupt(USART_INTERFACE);
 
+            strclr(comm.buffer);
             comm.bufferIndex = 0;
-            comm.state = COMM_RX_READY;
-        }
 
-        comm.previousChar = c;
-
-        break;
-
-    case COMM_TX:
-        if (usart_is_send_ready(USART_INTERFACE))
-        {
-            c = comm.buffer[comm.bufferIndex++];
-            if (c != '\0')
-                usart_send(USART_INTERFACE, c);
+            if (comm.transmitState == TRANSMIT_RESPONSE)
+                comm.state = COMM_RX;
             else
-            {
-                usart_disable_transmit_interrupt(USART_INTERFACE);
-
-                strclr(comm.buffer);
-                comm.bufferIndex = 0;
-
-                if (comm.transmitState == TRANSMIT_RESPONSE)
-                    comm.state = COMM_RX;
-                else
-                    comm.state = COMM_TX_READY;
-            }
+                comm.state = COMM_TX_READY;
         }
-
-        break;
-
-    default:
-        break;
     }
+#endif
 }
 
 #elif defined(USB_INTERFACE)
@@ -326,6 +366,17 @@ static const struct usb_string_descriptor *const dtable[] = {
 usbd_device usbdDevice;
 uint32_t usbdBuffer[0x20];
 
+static struct
+{
+    // Room for a chunk behind a partial packet
+    char buffer[COMM_BUFFER_SIZE + USB_DATA_PACKETSIZE_MAX];
+    uint32_t index;
+    uint32_t size;
+
+    volatile bool active;
+    bool fullPacket;
+} usbTransmit;
+
 static struct usb_cdc_line_coding cdc_line = {
     .dwDTERate = COMM_SERIAL_BAUDRATE,
     .bCharFormat = USB_CDC_1_STOP_BITS,
@@ -403,77 +454,90 @@ static usbd_respond onUSBControl(usbd_device *dev, usbd_ctlreq *req, usbd_rqc_ca
     return usbd_fail;
 }
 
-static void onUSBData(usbd_device *dev, uint8_t event, uint8_t ep)
+static void clearUSBTransmit(void)
 {
-    char receiveBuffer[USB_DATA_PACKETSIZE_MAX];
-    int32_t receivedBytes;
+    usbTransmit.index = 0;
+    usbTransmit.size = 0;
+    usbTransmit.active = false;
+    usbTransmit.fullPacket = false;
+}
 
-    if (event == usbd_evt_eprx)
-        receivedBytes = usbd_ep_read(dev, USB_DATA_RECEIVE_ENDPOINT, receiveBuffer, USB_DATA_PACKETSIZE_MAX);
-    else
-        receivedBytes = 0;
+static void queueUSBTransmitChunk(void)
+{
+    uint32_t size = usbTransmit.size - usbTransmit.index;
+    uint32_t chunkSize = strlen(comm.buffer);
 
-    if (!comm.open)
-        return;
+    memmove(usbTransmit.buffer, usbTransmit.buffer + usbTransmit.index, size);
+    memcpy(usbTransmit.buffer + size, comm.buffer, chunkSize);
 
-    switch (comm.state)
-    {
-    case COMM_RX:
-        for (int32_t i = 0;
-             i < receivedBytes;
-             i++)
-        {
-            char c = receiveBuffer[i];
+    usbTransmit.index = 0;
+    usbTransmit.size = size + chunkSize;
+
+    strclr(comm.buffer);
+    comm.bufferIndex = 0;
 
-            if ((c >= ' ') &&
-                (comm.bufferIndex < (COMM_BUFFER_SIZE - 1)))
-                comm.buffer[comm.bufferIndex++] = c;
-            else if ((c == '\r') ||
-                     ((c == '\n') &&
-                      (comm.previousChar != '\r')))
-            {
-                comm.buffer[comm.bufferIndex] = '\0';
+    if (comm.transmitState == TRANSMIT_RESPONSE)
+        comm.state = COMM_RX;
+    else
+        comm.state = COMM_TX_READY;
+}
 
-                comm.bufferIndex = 0;
-                comm.state = COMM_RX_READY;
+static void sendUSBPacket(usbd_device *dev)
+{
+    // Top up partial packets with the next chunk
+    if ((comm.state == COMM_TX) &&
+        ((usbTransmit.size - usbTransmit.index) < USB_DATA_PACKETSIZE_MAX))
+        queueUSBTransmitChunk();
 
-                // Dummy write to generate write interrupts
-                usbd_ep_write(dev, USB_DATA_TRANSMIT_ENDPOINT, NULL, 0);
-            }
+    uint32_t size = usbTransmit.size - usbTransmit.index;
+    if (size > USB_DATA_PACKETSIZE_MAX)
+        size = USB_DATA_PACKETSIZE_MAX;
 
-            comm.previousChar = c;
-        }
+    // A full last packet is followed by a zero-length packet
+    if (!size && !usbTransmit.fullPacket)
+    {
+        usbTransmit.active = false;
 
-        break;
+        return;
+    }
 
-    case COMM_TX:
+    if (usbd_ep_write(dev,
+                      USB_DATA_TRANSMIT_ENDPOINT,
+                      usbTransmit.buffer + usbTransmit.index,
+                      size) < 0)
     {
-        const char *sendBuffer = comm.buffer + comm.bufferIndex;
+        usbTransmit.active = false;
 
-        int32_t sentBytes = usbd_ep_write(dev, USB_DATA_TRANSMIT_ENDPOINT, sendBuffer, strlen(sendBuffer));
+        return;
+    }
 
-        comm.bufferIndex += sentBytes;
+    usbTransmit.index += size;
+    usbTransmit.active = true;
+    usbTransmit.fullPacket = (size == USB_DATA_PACKETSIZE_MAX);
+}
 
-        if (comm.buffer[comm.bufferIndex] == '\0')
-        {
-            strclr(comm.buffer);
-            comm.bufferIndex = 0;
+static void onUSBData(usbd_device *dev, uint8_t event, uint8_t ep)
+{
+    char receiveBuffer[USB_DATA_PACKETSIZE_MAX];
+    int32_t receivedBytes;
 
-            if (comm.transmitState == TRANSMIT_RESPONSE)
-                comm.state = COMM_RX;
-            else
-                comm.state = COMM_TX_READY;
-        }
+    if (event == usbd_evt_eprx)
+        receivedBytes = usbd_ep_read(dev, USB_DATA_RECEIVE_ENDPOINT, receiveBuffer, USB_DATA_PACKETSIZE_MAX);
+    else
+        receivedBytes = 0;
 
-        break;
-    }
+    if (!comm.open)
+        return;
 
-    case COMM_RX_READY:
-    case COMM_TX_READY:
-        usbd_ep_write(dev, USB_DATA_TRANSMIT_ENDPOINT, NULL, 0);
+    // Requests are queued while responses are sent
+    for (int32_t i = 0;
+         i < receivedBytes;
+         i++)
+        receiveComm(receiveBuffer[i]);
 
-        break;
-    }
+    // Write only when the previous packet has been sent
+    if (event == usbd_evt_eptx)
+        sendUSBPacket(dev);
 }
 
 static usbd_respond onUSBConfigure(usbd_device *dev, uint8_t cfg)
@@ -489,6 +553,8 @@ static usbd_respond onUSBConfigure(usbd_device *dev, uint8_t cfg)
         usbd_reg_endpoint(dev, USB_DATA_RECEIVE_ENDPOINT, NULL);
         usbd_reg_endpoint(dev, USB_DATA_TRANSMIT_ENDPOINT, NULL);
 
+        clearUSBTransmit();
+
         return usbd_ack;
 
     case 1:
@@ -500,6 +566,8 @@ static usbd_respond onUSBConfigure(usbd_device *dev, uint8_t cfg)
         usbd_reg_endpoint(dev, USB_DATA_RECEIVE_ENDPOINT, onUSBData);
         usbd_reg_endpoint(dev, USB_DATA_TRANSMIT_ENDPOINT, onUSBData);
 
+        clearUSBTransmit();
+
         return usbd_ack;
 
     default:
@@ -509,7 +577,15 @@ static usbd_respond onUSBConfigure(usbd_device *dev, uint8_t cfg)
 
 void transmitComm(void)
 {
+    NVIC_DisableIRQ(USB_IRQ);
+
     comm.state = COMM_TX;
+
+    // Otherwise queued when the previous packet completes
+    if (!usbTransmit.active)
+        sendUSBPacket(&usbdDevice);
+
+    NVIC_EnableIRQ(USB_IRQ);
 }
 
 void USB_IRQ_HANDLER(void)
@@ -548,6 +624,10 @@ void openComm(void)
     if (comm.open)
         return;
 
+    NVIC_DisableIRQ(USB_IRQ);
+    clearUSBTransmit();
+    NVIC_EnableIRQ(USB_IRQ);
+
     clearComm(true);
 }
 
@@ -13,6 +13,69 @@
 #include "../stm32/device.h"
 #include "../system/settings.h"
 
+// Display DMA
+
+#if defined(DISPLAY_SPI_DMA_CHANNEL)
+
+static bool displayDMAFrame16;
+
+static void setDisplayDMAFrame16(bool value)
+{
+    if (displayDMAFrame16 == value)
+        return;
+
+    spi_disable(DISPLAY_SPI);
+    spi_set_frame16(DISPLAY_SPI, value);
+    spi_enable(DISPLAY_SPI);
+
+    displayDMAFrame16 = value;
+}
+
+void initDisplayDMA(void)
+{
+    rcc_enable_dma(DISPLAY_SPI_DMA);
+
+    spi_enable_tx_dma(DISPLAY_SPI);
+}
+
+void sendDisplayBlock(const uint16_t *buffer, uint32_t count)
+{
+    while (dma_is_active(DISPLAY_SPI_DMA_CHANNEL))
+        ;
+
+    dma_disable(DISPLAY_SPI_DMA_CHANNEL);
+
+    if (!displayDMAFrame16)
+    {
+        spi_wait_until_transmitter_empty(DISPLAY_SPI);
+        spi_wait_while_busy(DISPLAY_SPI);
+
+        setDisplayDMAFrame16(true);
+    }
+
+    // 16-bit frames send pixels MSB first, as the display expects
+    dma_setup_memory16_to_peripheral16(DISPLAY_SPI_DMA_CHANNEL,
+                                       (uint32_t)&DISPLAY_SPI->DR,
+                                       (uint32_t)buffer,
+                                       count);
+    dma_enable(DISPLAY_SPI_DMA_CHANNEL);
+}
+
+void waitDisplayDMA(void)
+{
+    while (dma_is_active(DISPLAY_SPI_DMA_CHANNEL))
+        ;
+
+    spi_wait_until_transmitter_empty(DISPLAY_SPI);
+    spi_wait_while_busy(DISPLAY_SPI);
+
+    setDisplayDMAFrame16(false);
+}
+
+#endif
+
+// Backlight
+
 // Gamma-corrected linear brightness values:
 // [0.25, 0.5, 0.75, 1] ^ 2.2
 static const uint32_t displayOnTime[] = {
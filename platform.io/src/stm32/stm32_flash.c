@@ -26,6 +26,8 @@ __asm__(".section .comment\n"
         ".string \"FIRMWARE_SIZE: " TOSTRING(FIRMWARE_SIZE) "\"\n"
         ".string \"STATES_BASE: " TOSTRING(STATES_BASE) "\"\n"
         ".string \"STATES_SIZE: " TOSTRING(STATES_SIZE) "\"\n"
+        ".string \"HISTORY_BASE: " TOSTRING(HISTORY_BASE) "\"\n"
+        ".string \"HISTORY_SIZE: " TOSTRING(HISTORY_SIZE) "\"\n"
         ".string \"DATALOG_BASE: " TOSTRING(DATALOG_BASE) "\"\n"
         ".string \"DATALOG_SIZE: " TOSTRING(DATALOG_SIZE) "\"\n"
         ".section .text\n");
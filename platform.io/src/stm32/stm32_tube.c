@@ -29,6 +29,7 @@ struct
 
     uint32_t previousTick;
     uint32_t previousTimerCount;
+    uint32_t timestamp;
 } tubeHardware;
 
 void initTubeHardware(void)
@@ -119,13 +120,23 @@ void TUBE_DET_IRQ_HANDLER(void)
     tubeRandomBits = (tubeRandomBits << TUBE_BITS_PER_PULSE) | (timerCount & TUBE_BITS_PER_PULSE_MASK);
 
     uint32_t pulseIntervalTicks = timerTick - tubeHardware.previousTick;
+    uint16_t pulseInterval = timerCount - tubeHardware.previousTimerCount;
     if (pulseIntervalTicks < 50)
     {
-        uint16_t pulseInterval = timerCount - tubeHardware.previousTimerCount;
         if (pulseInterval < tubeDeadTime)
             tubeDeadTime = pulseInterval;
+
+        tubeHardware.timestamp += pulseInterval;
+    }
+    else
+    {
+        // Resolve timer wraparounds with the systick count
+        uint32_t approximateInterval = pulseIntervalTicks * (PULSE_MEASUREMENT_FREQUENCY / SYSTICK_FREQUENCY);
+        tubeHardware.timestamp += approximateInterval + (int16_t)(pulseInterval - (uint16_t)approximateInterval);
     }
 
+    pushTubePulseTimestamp(tubeHardware.timestamp);
+
     tubeHardware.previousTimerCount = timerCount;
     tubeHardware.previousTick = timerTick;
 }
@@ -218,7 +218,10 @@ static void disableVoice(void)
 
     // RCC
     rcc_disable_tim(VOICE_TX_TIMER);
+    // The DMA controller may be shared with the display and comm
+#if !defined(DISPLAY_SPI_DMA) && !defined(USART_TX_DMA)
     rcc_disable_dma(VOICE_TX_DMA);
+#endif
 
     voice.transmitting = false;
 }
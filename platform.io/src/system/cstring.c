@@ -19,35 +19,82 @@ void strclr(char *s)
     s[0] = '\0';
 }
 
+#else
+
+// External definition, for builds that don't inline
+extern inline void strclr(char *s);
+
 #endif
 
-void strcatChar(char *s, char c)
+// String builder
+
+void initStrBuf(StrBuf *b, char *s, size_t cap)
 {
-    s += strlen(s);
-    s[0] = c;
-    s[1] = '\0';
+    b->p = s;
+    b->len = 0;
+    b->cap = cap;
+
+    s[0] = '\0';
 }
 
-void strcatUInt32(char *s, uint32_t value, uint32_t minDigits)
+void clearStrBuf(StrBuf *b)
 {
-    char buffer[16];
-    char *p = buffer + sizeof(buffer) - 1;
+    b->len = 0;
+    b->p[0] = '\0';
+}
+
+void openStrBuf(StrBuf *b, char *s, size_t cap)
+{
+    b->p = s;
+    b->len = strlen(s);
+    b->cap = cap;
+}
+
+static void strbufData(StrBuf *b, const char *data, size_t size)
+{
+    // Truncates at the buffer end, always leaving room for the terminator
+    size_t available = b->cap - b->len - 1;
+    if (size > available)
+        size = available;
+
+    memcpy(b->p + b->len, data, size);
+    b->len += size;
+    b->p[b->len] = '\0';
+}
+
+void strbufChar(StrBuf *b, char c)
+{
+    if ((b->len + 1) >= b->cap)
+        return;
 
-    *p-- = '\0';
+    b->p[b->len++] = c;
+    b->p[b->len] = '\0';
+}
+
+void strbufString(StrBuf *b, const char *s)
+{
+    strbufData(b, s, strlen(s));
+}
+
+void strbufUInt32(StrBuf *b, uint32_t value, uint32_t minDigits)
+{
+    char buffer[16];
+    char *end = buffer + sizeof(buffer);
+    char *p = end;
 
     uint32_t digits = 0;
 
     do
     {
-        *p-- = '0' + (value % 10);
+        *--p = '0' + (value % 10);
         value /= 10;
         digits++;
-    } while (value || (digits < minDigits));
+    } while ((value || (digits < minDigits)) && (p > buffer));
 
-    strcat(s, p + 1);
+    strbufData(b, p, end - p);
 }
 
-void strcatTime(char *s, uint32_t time)
+void strbufTime(StrBuf *b, uint32_t time)
 {
     uint32_t hours = time / 3600;
     uint32_t hoursRemainder = time % 3600;
@@ -56,21 +103,21 @@ void strcatTime(char *s, uint32_t time)
 
     if (hours)
     {
-        strcatUInt32(s, hours, 0);
-        strcatChar(s, ':');
+        strbufUInt32(b, hours, 0);
+        strbufChar(b, ':');
     }
 
-    strcatUInt32(s, minutes, 2);
-    strcatChar(s, ':');
+    strbufUInt32(b, minutes, 2);
+    strbufChar(b, ':');
 
-    strcatUInt32(s, seconds, 2);
+    strbufUInt32(b, seconds, 2);
 }
 
-void strcatFloat(char *s, float value, uint32_t fractionalDecimals)
+void strbufFloat(StrBuf *b, float value, uint32_t fractionalDecimals)
 {
     if (value < 0.0F)
     {
-        strcatChar(s, '-');
+        strbufChar(b, '-');
         value = -value;
     }
 
@@ -81,12 +128,12 @@ void strcatFloat(char *s, float value, uint32_t fractionalDecimals)
     uint32_t integerPart = scaled / decimalPower;
     uint32_t fractionalPart = scaled % decimalPower;
 
-    strcatUInt32(s, integerPart, 0);
+    strbufUInt32(b, integerPart, 0);
 
     if (fractionalDecimals)
     {
-        strcatChar(s, '.');
-        strcatUInt32(s, fractionalPart, fractionalDecimals);
+        strbufChar(b, '.');
+        strbufUInt32(b, fractionalPart, fractionalDecimals);
     }
 }
 
@@ -100,21 +147,21 @@ cstring metricPrefixStrings[8] = {
     STRING_GIGA,
 };
 
-static void strcatMetricPrefix(char *s, int32_t prefixIndex)
+static void strbufMetricPrefix(StrBuf *b, int32_t prefixIndex)
 {
     uint32_t index = prefixIndex + 3;
     if (index > 6)
         index = 3;
-    strcat(s, getString(metricPrefixStrings[index]));
+    strbufString(b, getString(metricPrefixStrings[index]));
 }
 
-void strcatMetricValue(char *s, char *u, float value, int32_t minPrefixIndex)
+void strbufMetricValue(StrBuf *b, StrBuf *u, float value, int32_t minPrefixIndex)
 {
     int32_t prefixIndex;
 
     if (value == 0.0F)
     {
-        strcat(s, "‒.‒‒‒"); // Uses figure dash (U+2012)
+        strbufString(b, "‒.‒‒‒"); // Uses figure dash (U+2012)
         prefixIndex = 0;
     }
     else
@@ -135,13 +182,13 @@ void strcatMetricValue(char *s, char *u, float value, int32_t minPrefixIndex)
         if (fractionalDecimals < 0)
             fractionalDecimals = 0;
 
-        strcatFloat(s, scaled, fractionalDecimals);
+        strbufFloat(b, scaled, fractionalDecimals);
     }
 
-    strcatMetricPrefix(u, prefixIndex);
+    strbufMetricPrefix(u, prefixIndex);
 }
 
-void strcatMetricPower(char *s, int32_t exponent, int32_t minPrefixIndex)
+void strbufMetricPower(StrBuf *b, int32_t exponent, int32_t minPrefixIndex)
 {
     int32_t prefixIndex = divideDown(exponent, 3);
     uint32_t fractionalDecimals = 0;
@@ -150,10 +197,10 @@ void strcatMetricPower(char *s, int32_t exponent, int32_t minPrefixIndex)
         prefixIndex = minPrefixIndex;
         fractionalDecimals = minPrefixIndex * 3 - exponent;
     }
-    strcatFloat(s, powf(10.0F, exponent - 3 * prefixIndex), fractionalDecimals);
+    strbufFloat(b, powf(10.0F, exponent - 3 * prefixIndex), fractionalDecimals);
     if (prefixIndex)
-        strcatChar(s, ' ');
-    strcatMetricPrefix(s, prefixIndex);
+        strbufChar(b, ' ');
+    strbufMetricPrefix(b, prefixIndex);
 }
 
 const char *hexDigits = "0123456789abcdef";
@@ -163,40 +210,97 @@ static inline char getHexDigit(uint32_t value)
     return hexDigits[value];
 }
 
-void strcatUInt8Hex(char *s, uint8_t value)
+void strbufUInt8Hex(StrBuf *b, uint8_t value)
 {
-    s += strlen(s);
+    char buffer[2] = {
+        getHexDigit((value >> 4) & 0xf),
+        getHexDigit((value >> 0) & 0xf),
+    };
 
-    *s++ = getHexDigit((value >> 4) & 0xf);
-    *s++ = getHexDigit((value >> 0) & 0xf);
+    strbufData(b, buffer, sizeof(buffer));
+}
 
-    *s++ = '\0';
+void strbufUInt16Hex(StrBuf *b, uint16_t value)
+{
+    strbufUInt8Hex(b, value >> 8);
+    strbufUInt8Hex(b, value & 0xff);
 }
 
-void strcatUInt16Hex(char *s, uint16_t value)
+void strbufUInt32Hex(StrBuf *b, uint32_t value)
 {
-    strcatUInt8Hex(s, value >> 8);
-    strcatUInt8Hex(s, value & 0xff);
+    strbufUInt16Hex(b, value >> 16);
+    strbufUInt16Hex(b, value & 0xffff);
 }
 
-void strcatUInt32Hex(char *s, uint32_t value)
+void strbufHexData(StrBuf *b, const uint8_t *data, uint32_t n)
 {
-    strcatUInt16Hex(s, value >> 16);
-    strcatUInt16Hex(s, value & 0xffff);
+    for (uint32_t i = 0; i < n; i++)
+        strbufUInt8Hex(b, *data++);
 }
 
-void strcatHexData(char *s, uint8_t *data, uint32_t n)
+// Unbounded appends to terminated strings
+
+void strcatChar(char *s, char c)
 {
-    s += strlen(s);
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufChar(&b, c);
+}
 
-    for (uint32_t i = 0; i < n; i++)
-    {
-        uint8_t value = *data++;
-        *s++ = getHexDigit((value >> 4) & 0xf);
-        *s++ = getHexDigit((value >> 0) & 0xf);
-    }
+void strcatUInt32(char *s, uint32_t value, uint32_t minDigits)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufUInt32(&b, value, minDigits);
+}
 
-    *s++ = '\0';
+void strcatTime(char *s, uint32_t time)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufTime(&b, time);
+}
+
+void strcatFloat(char *s, float value, uint32_t fractionalDecimals)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufFloat(&b, value, fractionalDecimals);
+}
+
+void strcatMetricPower(char *s, int32_t exponent, int32_t minPrefixIndex)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufMetricPower(&b, exponent, minPrefixIndex);
+}
+
+void strcatUInt8Hex(char *s, uint8_t value)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufUInt8Hex(&b, value);
+}
+
+void strcatUInt16Hex(char *s, uint16_t value)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufUInt16Hex(&b, value);
+}
+
+void strcatUInt32Hex(char *s, uint32_t value)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufUInt32Hex(&b, value);
+}
+
+void strcatHexData(char *s, const uint8_t *data, uint32_t n)
+{
+    StrBuf b;
+    openStrBuf(&b, s, SIZE_MAX);
+    strbufHexData(&b, data, n);
 }
 
 bool parseToken(const char **s, const char *match)
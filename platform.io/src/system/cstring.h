@@ -20,6 +20,13 @@
 
 typedef const char *const cstring;
 
+typedef struct
+{
+    char *p;
+    size_t len;
+    size_t cap;
+} StrBuf;
+
 #if defined(__EMSCRIPTEN__)
 
 void strclr(char *s);
@@ -33,18 +40,35 @@ inline void strclr(char *s)
 
 #endif
 
+void initStrBuf(StrBuf *b, char *s, size_t cap);
+void clearStrBuf(StrBuf *b);
+void openStrBuf(StrBuf *b, char *s, size_t cap);
+
+void strbufChar(StrBuf *b, char c);
+void strbufString(StrBuf *b, const char *s);
+
+void strbufUInt32(StrBuf *b, uint32_t value, uint32_t minDigits);
+void strbufTime(StrBuf *b, uint32_t time);
+void strbufFloat(StrBuf *b, float value, uint32_t fractionalDecimals);
+void strbufMetricValue(StrBuf *b, StrBuf *u, float value, int32_t minPrefixIndex);
+void strbufMetricPower(StrBuf *b, int32_t exponent, int32_t minPrefixIndex);
+
+void strbufUInt8Hex(StrBuf *b, uint8_t value);
+void strbufUInt16Hex(StrBuf *b, uint16_t value);
+void strbufUInt32Hex(StrBuf *b, uint32_t value);
+void strbufHexData(StrBuf *b, const uint8_t *data, uint32_t size);
+
 void strcatChar(char *s, char c);
 
 void strcatUInt32(char *s, uint32_t value, uint32_t minDigits);
 void strcatTime(char *s, uint32_t time);
 void strcatFloat(char *s, float value, uint32_t fractionalDecimals);
-void strcatMetricValue(char *s, char *u, float value, int32_t minPrefixIndex);
 void strcatMetricPower(char *s, int32_t exponent, int32_t minPrefixIndex);
 
 void strcatUInt8Hex(char *s, uint8_t value);
 void strcatUInt16Hex(char *s, uint16_t value);
 void strcatUInt32Hex(char *s, uint32_t value);
-void strcatHexData(char *s, uint8_t *data, uint32_t size);
+void strcatHexData(char *s, const uint8_t *data, uint32_t size);
 
 bool parseToken(const char **s, const char *match);
 bool parseUInt32(const char **s, uint32_t *value);
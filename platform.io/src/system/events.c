@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 
+#include "../bench/bench.h"
 #include "../extras/rng.h"
 #include "../measurements/datalog.h"
 #include "../measurements/pulses.h"
@@ -16,6 +17,7 @@
 #include "../peripherals/buzzer.h"
 #include "../peripherals/comm.h"
 #include "../peripherals/display.h"
+#include "../peripherals/flash.h"
 #include "../peripherals/keyboard.h"
 #include "../peripherals/led.h"
 #include "../peripherals/pulsesoundenable.h"
@@ -139,7 +141,8 @@ static TimerState tickTimer(volatile int32_t *timer)
 void onTick(void)
 {
     // Pulses
-    onPulseTick();
+    BENCH_PROBE(BENCH_PROBE_ONPULSETICK, onPulseTick());
+    onDatalogTick();
 
     // ADC
 #if defined(EMFMETER)
@@ -276,7 +279,8 @@ void updateEvents(void)
         updateViewHeartbeat();
     }
 
-    updateDatalog();
+    BENCH_PROBE(BENCH_PROBE_UPDATEDATALOG, updateDatalog());
+    updateFlash();
     updateRNG();
     updateView();
 }
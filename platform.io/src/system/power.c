@@ -7,6 +7,7 @@
  * License: MIT
  */
 
+#include "../bench/bench.h"
 #include "../extras/game.h"
 #include "../extras/rng.h"
 #include "../measurements/datalog.h"
@@ -94,7 +95,7 @@ static void onPowerOnViewEvent(ViewEvent event)
         if (power.onViewState == POWERON_VIEW_SPLASH)
         {
             initRTC();
-            loadHistory();
+            BENCH_PROBE(BENCH_PROBE_LOADHISTORY, loadHistory());
         }
 
         break;
@@ -238,6 +239,7 @@ static void powerOffWithBatteryIndicator(bool batteryIndicator)
         setMeasurementsEnabled(false);
         saveSettings();
         stopDatalog();
+        saveHistory();
         setKeyboardMode(KEYBOARD_MODE_MEASUREMENT);
     }
 
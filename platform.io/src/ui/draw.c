@@ -168,6 +168,206 @@ const mr_rectangle_t contentRectangle = {
 
 mr_t mr;
 
+// Glyph cache: keeps the decoded large font glyphs in RAM, so the
+// measurement value is not decompressed from flash on every frame.
+
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+static uint8_t glyphCache[GLYPH_CACHE_SIZE];
+#endif
+
+void initDraw(void)
+{
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT)
+    mr_set_glyph_cache(&mr, font_large, glyphCache, sizeof(glyphCache));
+#endif
+}
+
+static uint32_t hashDrawData(uint32_t hash, const void *data, uint32_t size)
+{
+    // FNV-1a
+    const uint8_t *p = (const uint8_t *)data;
+
+    for (uint32_t i = 0; i < size; i++)
+        hash = (hash ^ p[i]) * 0x01000193;
+
+    return hash;
+}
+
+// Draw cache: on color displays, skips draw calls whose output is already on
+// screen from the previous frame. Calls are matched by their order within
+// the frame. A call is redrawn if its rectangle or contents changed, if it
+// was partially covered by a later call in the previous frame, or if an
+// earlier call of this frame drew over it.
+
+#if defined(DISPLAY_COLOR)
+
+#if !defined(DRAW_CACHE_SLOT_NUM)
+#define DRAW_CACHE_SLOT_NUM 64
+#endif
+
+#define DRAW_CACHE_HASH_RECTANGLE 0x811c9dc5
+#define DRAW_CACHE_HASH_IMAGE 0x050c5d1f
+#define DRAW_CACHE_HASH_TEXT 0x4b1d2a6e
+
+#define DRAW_CACHE_SLOT_DRAWN (1 << 0)
+#define DRAW_CACHE_SLOT_OVERDRAWN (1 << 1)
+
+typedef struct
+{
+    mr_rectangle_t rectangle;
+    uint32_t hash;
+} DrawCacheSlot;
+
+static struct
+{
+    bool valid;
+    bool active;
+
+    uint32_t slotIndex;
+    uint32_t slotNum;
+
+    bool overflow;
+    mr_rectangle_t overflowRectangle;
+
+    DrawCacheSlot slots[DRAW_CACHE_SLOT_NUM];
+    uint8_t slotFlags[DRAW_CACHE_SLOT_NUM];
+} drawCache;
+
+static bool isRectangleIntersecting(const mr_rectangle_t *a, const mr_rectangle_t *b)
+{
+    return (a->x < (b->x + b->width)) &&
+           (b->x < (a->x + a->width)) &&
+           (a->y < (b->y + b->height)) &&
+           (b->y < (a->y + a->height));
+}
+
+static bool isRectangleEqual(const mr_rectangle_t *a, const mr_rectangle_t *b)
+{
+    return (a->x == b->x) &&
+           (a->y == b->y) &&
+           (a->width == b->width) &&
+           (a->height == b->height);
+}
+
+static void addOverflowRectangle(const mr_rectangle_t *rectangle)
+{
+    if (!drawCache.overflow)
+    {
+        drawCache.overflow = true;
+        drawCache.overflowRectangle = *rectangle;
+
+        return;
+    }
+
+    mr_rectangle_t *r = &drawCache.overflowRectangle;
+    int16_t right = r->x + r->width;
+    int16_t bottom = r->y + r->height;
+
+    if (rectangle->x < r->x)
+        r->x = rectangle->x;
+    if (rectangle->y < r->y)
+        r->y = rectangle->y;
+    if ((rectangle->x + rectangle->width) > right)
+        right = rectangle->x + rectangle->width;
+    if ((rectangle->y + rectangle->height) > bottom)
+        bottom = rectangle->y + rectangle->height;
+
+    r->width = right - r->x;
+    r->height = bottom - r->y;
+}
+
+static bool isDrawCached(const mr_rectangle_t *rectangle, uint32_t hash)
+{
+    if (!drawCache.active)
+    {
+        // Drawing outside a frame: screen no longer matches the cache
+        drawCache.valid = false;
+
+        return false;
+    }
+
+    uint32_t index = drawCache.slotIndex++;
+    if (index >= DRAW_CACHE_SLOT_NUM)
+    {
+        addOverflowRectangle(rectangle);
+
+        return false;
+    }
+
+    DrawCacheSlot *slot = &drawCache.slots[index];
+
+    bool cached = drawCache.valid &&
+                  (index < drawCache.slotNum) &&
+                  (slot->hash == hash) &&
+                  isRectangleEqual(&slot->rectangle, rectangle) &&
+                  !(drawCache.slotFlags[index] & DRAW_CACHE_SLOT_OVERDRAWN);
+
+    // Damaged by an earlier call of this frame?
+    for (uint32_t i = 0; cached && (i < index); i++)
+    {
+        if ((drawCache.slotFlags[i] & DRAW_CACHE_SLOT_DRAWN) &&
+            isRectangleIntersecting(&drawCache.slots[i].rectangle, rectangle))
+            cached = false;
+    }
+
+    slot->rectangle = *rectangle;
+    slot->hash = hash;
+    drawCache.slotFlags[index] = cached ? 0 : DRAW_CACHE_SLOT_DRAWN;
+
+    return cached;
+}
+
+#endif
+
+void startDrawFrame(void)
+{
+#if defined(DISPLAY_COLOR)
+    drawCache.active = true;
+    drawCache.slotIndex = 0;
+    drawCache.overflow = false;
+#endif
+}
+
+void finishDrawFrame(void)
+{
+#if defined(DISPLAY_COLOR)
+    drawCache.active = false;
+
+    uint32_t slotNum = drawCache.slotIndex;
+    if (slotNum > DRAW_CACHE_SLOT_NUM)
+        slotNum = DRAW_CACHE_SLOT_NUM;
+
+    // Mark calls partially covered by later calls
+    for (uint32_t i = 0; i < slotNum; i++)
+    {
+        const mr_rectangle_t *rectangle = &drawCache.slots[i].rectangle;
+        uint8_t slotFlags = 0;
+
+        if (drawCache.overflow &&
+            isRectangleIntersecting(rectangle, &drawCache.overflowRectangle))
+            slotFlags = DRAW_CACHE_SLOT_OVERDRAWN;
+
+        for (uint32_t j = i + 1; !slotFlags && (j < slotNum); j++)
+        {
+            if (isRectangleIntersecting(rectangle, &drawCache.slots[j].rectangle))
+                slotFlags = DRAW_CACHE_SLOT_OVERDRAWN;
+        }
+
+        drawCache.slotFlags[i] = slotFlags;
+    }
+
+    drawCache.slotNum = slotNum;
+    drawCache.valid = true;
+#endif
+}
+
+void invalidateDrawCache(void)
+{
+#if defined(DISPLAY_COLOR)
+    drawCache.valid = false;
+#endif
+}
+
 // Low-level functions
 
 mr_color_t getFillColor(ColorIndex colorIndex)
@@ -209,6 +409,12 @@ void setStrokeColor(ColorIndex colorIndex)
 
 void drawRectangle(const mr_rectangle_t *rectangle)
 {
+#if defined(DISPLAY_COLOR)
+    uint32_t hash = hashDrawData(DRAW_CACHE_HASH_RECTANGLE, &mr.fill_color, sizeof(mr.fill_color));
+    if (isDrawCached(rectangle, hash))
+        return;
+#endif
+
     mr_draw_rectangle(&mr, rectangle);
 }
 
@@ -248,6 +454,14 @@ void ditherRectangle(const mr_rectangle_t *rectangle, bool dark)
 
 void drawImage(const mr_rectangle_t *rectangle, const mr_color_t *imageBuffer)
 {
+#if defined(DISPLAY_COLOR)
+    uint32_t hash = hashDrawData(DRAW_CACHE_HASH_IMAGE,
+                                 imageBuffer,
+                                 rectangle->width * rectangle->height * sizeof(mr_color_t));
+    if (isDrawCached(rectangle, hash))
+        return;
+#endif
+
     mr_draw_image(&mr, rectangle, imageBuffer);
 }
 
@@ -256,9 +470,64 @@ void setFont(const uint8_t *font)
     mr_set_font(&mr, font);
 }
 
+// Text width cache: labels are measured on every frame, and each
+// measurement decodes the metrics of every glyph from the font.
+
+#if !defined(TEXT_WIDTH_CACHE_SIZE)
+#define TEXT_WIDTH_CACHE_SIZE 16
+#endif
+
+#define TEXT_WIDTH_CACHE_HASH 0x2d358dcc
+
+typedef struct
+{
+    const uint8_t *font;
+    uint32_t hash;
+    uint32_t length;
+    uint32_t lastUse;
+    uint16_t width;
+} TextWidthCacheEntry;
+
+static struct
+{
+    uint32_t useCount;
+
+    TextWidthCacheEntry entries[TEXT_WIDTH_CACHE_SIZE];
+} textWidthCache;
+
 uint16_t getTextWidth(const char *text)
 {
-    return mr_get_utf8_text_width(&mr, (const uint8_t *)text);
+    uint32_t length = strlen(text);
+    uint32_t hash = hashDrawData(TEXT_WIDTH_CACHE_HASH, text, length);
+
+    TextWidthCacheEntry *leastRecentEntry = &textWidthCache.entries[0];
+    uint32_t useCount = ++textWidthCache.useCount;
+
+    for (uint32_t i = 0; i < TEXT_WIDTH_CACHE_SIZE; i++)
+    {
+        TextWidthCacheEntry *entry = &textWidthCache.entries[i];
+
+        if ((entry->font == mr.font) &&
+            (entry->hash == hash) &&
+            (entry->length == length))
+        {
+            entry->lastUse = useCount;
+
+            return entry->width;
+        }
+
+        // Wrap-safe age comparison
+        if ((useCount - entry->lastUse) > (useCount - leastRecentEntry->lastUse))
+            leastRecentEntry = entry;
+    }
+
+    leastRecentEntry->font = mr.font;
+    leastRecentEntry->hash = hash;
+    leastRecentEntry->length = length;
+    leastRecentEntry->lastUse = useCount;
+    leastRecentEntry->width = mr_get_utf8_text_width(&mr, (const uint8_t *)text);
+
+    return leastRecentEntry->width;
 }
 
 uint16_t getTextHeight(void)
@@ -305,34 +574,41 @@ static void drawAlignedText(const char *text, const mr_rectangle_t *rectangle, c
         break;
     }
 
-    if (getTextWidth(text) <= width)
+    int16_t textWidth = getTextWidth(text);
+
+    if (textWidth <= width)
         str = text;
     else
     {
-        strcpy(buffer, text);
-        for (uint32_t i = strlen(text); i > 0; i--)
-        {
-            // Skip UTF-8 continuation bytes
-            if ((((uint8_t)buffer[i]) >> 6) == 0x02)
-                continue;
-
-            strcpy(buffer + i, getString(STRING_ELLIPSIS));
-            if (getTextWidth(buffer) <= width)
-                break;
-        }
+        // Longest prefix that fits next to the ellipsis, in a single pass
+        const char *ellipsis = getString(STRING_ELLIPSIS);
+        uint32_t ellipsisLength = strlen(ellipsis);
+        int16_t ellipsisWidth = getTextWidth(ellipsis);
+
+        int16_t prefixWidth;
+        uint32_t prefixLength = mr_get_utf8_text_fit(&mr,
+                                                     (const uint8_t *)text,
+                                                     width - ellipsisWidth,
+                                                     sizeof(buffer) - ellipsisLength - 1,
+                                                     &prefixWidth);
+
+        memcpy(buffer, text, prefixLength);
+        memcpy(buffer + prefixLength, ellipsis, ellipsisLength + 1);
         str = buffer;
+
+        textWidth = prefixWidth + ellipsisWidth;
     }
 
     mr_point_t strOffset = *offset;
     switch (textAlignment)
     {
     case TEXTALIGNMENT_CENTERED:
-        strOffset.x -= getTextWidth(str) / 2;
+        strOffset.x -= textWidth / 2;
 
         break;
 
     case TEXTALIGNMENT_RIGHTALIGNED:
-        strOffset.x -= getTextWidth(str);
+        strOffset.x -= textWidth;
 
         break;
 
@@ -340,6 +616,16 @@ static void drawAlignedText(const char *text, const mr_rectangle_t *rectangle, c
         break;
     }
 
+#if defined(DISPLAY_COLOR)
+    uint32_t hash = hashDrawData(DRAW_CACHE_HASH_TEXT, &strOffset, sizeof(strOffset));
+    hash = hashDrawData(hash, &mr.font, sizeof(mr.font));
+    hash = hashDrawData(hash, &mr.stroke_color, sizeof(mr.stroke_color));
+    hash = hashDrawData(hash, &mr.fill_color, sizeof(mr.fill_color));
+    hash = hashDrawData(hash, str, strlen(str));
+    if (isDrawCached(rectangle, hash))
+        return;
+#endif
+
     mr_draw_utf8_text(&mr, (const uint8_t *)str, rectangle, &strOffset);
 }
 
@@ -398,7 +684,9 @@ static const char *getWrappedTextLine(const char *src, char *line)
         destWord += wordLength;
         *destWord = '\0';
 
-        if (!firstWord && getTextWidth(line) > CONTENT_MULTILINE_WIDTH)
+        // Partial lines are measured uncached, as they would evict labels
+        if (!firstWord &&
+            (mr_get_utf8_text_width(&mr, (const uint8_t *)line) > CONTENT_MULTILINE_WIDTH))
             break;
 
         src = srcWord;
@@ -140,6 +140,16 @@ typedef enum
 #endif
 #endif
 
+// Glyph cache: holds the decoded large font digits and decimal point
+
+#if defined(MCURENDERER_GLYPH_CACHE_SUPPORT) && !defined(GLYPH_CACHE_SIZE)
+#if defined(DISPLAY_320X240)
+#define GLYPH_CACHE_SIZE 6656
+#else
+#define GLYPH_CACHE_SIZE 4608
+#endif
+#endif
+
 #define TITLEBAR_LEFT 0
 #define TITLEBAR_TOP 0
 #define TITLEBAR_WIDTH DISPLAY_WIDTH
@@ -166,6 +176,12 @@ mr_color_t getFillColor(ColorIndex colorIndex);
 void setFillColor(ColorIndex colorIndex);
 void setStrokeColor(ColorIndex colorIndex);
 
+void initDraw(void);
+
+void startDrawFrame(void);
+void finishDrawFrame(void);
+void invalidateDrawCache(void);
+
 void drawRectangle(const mr_rectangle_t *rectangle);
 void ditherRectangle(const mr_rectangle_t *rectangle, bool darker);
 
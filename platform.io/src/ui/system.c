@@ -96,6 +96,9 @@ void drawTitleBar(const char *title)
         drawRowRight(settings.pulseSound ? "9" : "8", &rectangle);
 
     // Title
+#if defined(SIMULATOR) && !defined(BENCHMARK)
+    setDisplayViewName(title);
+#endif
     setFont(font_small);
     setStrokeColor(COLOR_ELEMENT_ACTIVE);
     drawRowLeft(title, &rectangle);
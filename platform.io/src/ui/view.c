@@ -13,6 +13,7 @@
 #include "../system/events.h"
 #include "../system/power.h"
 #include "../system/settings.h"
+#include "../ui/draw.h"
 #include "../ui/view.h"
 
 static struct
@@ -95,7 +96,11 @@ void updateView(void)
             view.drawUpdate = false;
 
             if (isDisplayEnabled())
+            {
                 setDisplayEnabled(false);
+
+                invalidateDrawCache();
+            }
         }
 #endif
     }
@@ -105,7 +110,7 @@ void updateView(void)
     {
         view.drawUpdate = false;
 
-        view.onViewEvent(EVENT_DRAW);
+        drawView();
 
 #if defined(DISPLAY_MONOCHROME)
         refreshDisplay();
@@ -122,6 +127,17 @@ void updateView(void)
     }
 }
 
+void drawView(void)
+{
+    startDrawFrame();
+    view.onViewEvent(EVENT_DRAW);
+    finishDrawFrame();
+
+#if defined(SIMULATOR) && !defined(BENCHMARK)
+    onDisplayFrame();
+#endif
+}
+
 void requestViewUpdate(void)
 {
     view.drawUpdate = true;
@@ -131,6 +147,7 @@ void showView(OnViewEvent *onViewEvent)
 {
     view.onViewEvent = onViewEvent;
 
+    invalidateDrawCache();
     requestViewUpdate();
 }
 
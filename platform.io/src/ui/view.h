@@ -41,6 +41,7 @@ typedef void ShowView(void);
 void initView(void);
 
 void updateView(void);
+void drawView(void);
 
 void requestViewUpdate(void);
 void showView(OnViewEvent *onViewEvent);
@@ -0,0 +1,350 @@
+/*
+ * Rad Pro
+ * Data log decoder
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#include <stdbool.h>
+
+#include "radpro-datalog.h"
+
+// Keep in sync with platform.io/src/measurements/datalog.c
+
+#define DATALOG_ENTRY_DELTAOFDELTA_RUN 0x60
+#define DATALOG_ENTRY_INCREMENTAL_2BYTES 0x80
+#define DATALOG_ENTRY_INCREMENTAL_3BYTES 0xc0
+#define DATALOG_ENTRY_INCREMENTAL_4BYTES 0xe0
+#define DATALOG_ENTRY_INCREMENTAL_5BYTES 0xf0
+#define DATALOG_ENTRY_ABSOLUTE 0xf1
+#define DATALOG_ENTRY_BURST_8BIT 0xf6
+#define DATALOG_ENTRY_BURST_16BIT 0xf7
+#define DATALOG_ENTRY_SESSION_START 0xf8
+#define DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA 0xf9
+#define DATALOG_ENTRY_EMPTY 0xff
+
+#define DATALOG_RUN_LENGTH_MIN 2
+
+#define DATALOG_LOGGINGMODE_NUM 6
+
+typedef enum
+{
+    PAGESTATE_FULL = 0x00,
+    PAGESTATE_RESET = 0x01,
+    PAGESTATE_WRITABLE = 0xff,
+} PageState;
+
+static const uint16_t loggingModeIntervals[] = {
+    0,
+    60 * 60,
+    10 * 60,
+    1 * 60,
+    10,
+    1,
+};
+
+typedef struct
+{
+    const uint8_t *image;
+    uint32_t pageSize;
+    uint32_t pageNum;
+    uint32_t pageStateOffset;
+    uint32_t wordSize;
+
+    uint32_t timeInterval;
+    uint32_t time;
+    uint16_t milliseconds;
+    uint32_t pulseCount;
+    bool sessionStart;
+
+    bool deltaOfDelta;
+    uint32_t delta;
+
+    uint32_t *timeColumn;
+    uint16_t *millisecondsColumn;
+    uint32_t *pulseCountColumn;
+    uint8_t *sessionStartColumn;
+    size_t maxRecordNum;
+    size_t recordNum;
+} Decoder;
+
+// Page management
+
+static PageState readPageState(const Decoder *decoder, uint32_t pageIndex)
+{
+    const uint8_t *pageStateData = decoder->image +
+                                   pageIndex * decoder->pageSize +
+                                   decoder->pageStateOffset;
+
+    // Check page state trailing bytes
+    for (uint32_t i = 1; i < decoder->wordSize; i++)
+        if (pageStateData[i] != 0xff)
+            return PAGESTATE_RESET;
+
+    // Check page state first byte
+    PageState pageState = pageStateData[0];
+
+    switch (pageState)
+    {
+    case PAGESTATE_FULL:
+    case PAGESTATE_WRITABLE:
+        return pageState;
+
+    default:
+        return PAGESTATE_RESET;
+    }
+}
+
+static bool getDatalogHead(const Decoder *decoder, uint32_t *headPageIndex, uint32_t *tailPageIndex)
+{
+    // Get most recent datalog page: the writable page after a written one,
+    // as the page following it may already be erased
+    uint32_t pageIndex = 0;
+    while (true)
+    {
+        if (pageIndex >= decoder->pageNum)
+        {
+            // Nothing written yet
+            if (readPageState(decoder, 0) != PAGESTATE_WRITABLE)
+                return false;
+
+            pageIndex = 0;
+
+            break;
+        }
+
+        uint32_t previousPageIndex = pageIndex ? (pageIndex - 1) : (decoder->pageNum - 1);
+
+        if ((readPageState(decoder, pageIndex) == PAGESTATE_WRITABLE) &&
+            (readPageState(decoder, previousPageIndex) != PAGESTATE_WRITABLE))
+            break;
+
+        pageIndex++;
+    }
+
+    *tailPageIndex = pageIndex;
+
+    // Move back to oldest datalog page
+    for (uint32_t i = 1; i < decoder->pageNum; i++)
+    {
+        uint32_t previousPageIndex = pageIndex ? (pageIndex - 1) : (decoder->pageNum - 1);
+
+        if (readPageState(decoder, previousPageIndex) != PAGESTATE_FULL)
+            break;
+
+        pageIndex = previousPageIndex;
+    }
+
+    *headPageIndex = pageIndex;
+
+    return true;
+}
+
+// Record output
+
+static void emitRecord(Decoder *decoder)
+{
+    size_t index = decoder->recordNum++;
+
+    if (index < decoder->maxRecordNum)
+    {
+        decoder->timeColumn[index] = decoder->time;
+        decoder->millisecondsColumn[index] = decoder->milliseconds;
+        decoder->pulseCountColumn[index] = decoder->pulseCount;
+        decoder->sessionStartColumn[index] = decoder->sessionStart;
+    }
+
+    decoder->sessionStart = false;
+}
+
+// Page decoder
+
+static uint32_t decodeFixedUInt32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | ((uint32_t)p[3] << 0);
+}
+
+static void emitIncrementalRecord(Decoder *decoder, uint32_t value)
+{
+    if (decoder->deltaOfDelta)
+    {
+        // Zig-zag coded difference to the previous delta
+        decoder->delta += (value >> 1) ^ -(value & 1);
+        value = decoder->delta;
+    }
+
+    decoder->pulseCount += value;
+    decoder->time += decoder->timeInterval;
+    emitRecord(decoder);
+}
+
+static void emitBurstRecords(Decoder *decoder, const uint8_t *p, uint32_t sampleNum, uint32_t sampleSize)
+{
+    // Samples split one second evenly
+    for (uint32_t i = 0; i < sampleNum; i++)
+    {
+        const uint8_t *sample = p + i * sampleSize;
+        decoder->pulseCount += (sampleSize == 2) ? ((sample[0] << 8) | sample[1]) : sample[0];
+
+        if ((i + 1) < sampleNum)
+            decoder->milliseconds = (i + 1) * 1000 / sampleNum;
+        else
+        {
+            decoder->time++;
+            decoder->milliseconds = 0;
+        }
+
+        emitRecord(decoder);
+    }
+}
+
+static void decodePage(Decoder *decoder, uint32_t pageIndex, bool writable)
+{
+    const uint8_t *p = decoder->image + pageIndex * decoder->pageSize;
+    const uint8_t *end = p + decoder->pageStateOffset;
+
+    while (p < end)
+    {
+        uint8_t c = *p;
+
+        // 1-byte incremental values are by far the most common entry
+        if (c < DATALOG_ENTRY_INCREMENTAL_2BYTES)
+        {
+            if (decoder->deltaOfDelta && (c >= DATALOG_ENTRY_DELTAOFDELTA_RUN))
+            {
+                // Repeated delta
+                uint32_t runLength = (c - DATALOG_ENTRY_DELTAOFDELTA_RUN) + DATALOG_RUN_LENGTH_MIN;
+
+                for (uint32_t i = 0; i < runLength; i++)
+                    emitIncrementalRecord(decoder, 0);
+            }
+            else
+                emitIncrementalRecord(decoder, c);
+
+            p++;
+
+            continue;
+        }
+
+        uint32_t entrySize;
+        if (c < DATALOG_ENTRY_INCREMENTAL_3BYTES)
+            entrySize = 2;
+        else if (c < DATALOG_ENTRY_INCREMENTAL_4BYTES)
+            entrySize = 3;
+        else if (c < DATALOG_ENTRY_INCREMENTAL_5BYTES)
+            entrySize = 4;
+        else if (c == DATALOG_ENTRY_INCREMENTAL_5BYTES)
+            entrySize = 5;
+        else if (c < (DATALOG_ENTRY_ABSOLUTE + (DATALOG_LOGGINGMODE_NUM - 1)))
+            entrySize = 9;
+        else if ((c >= DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA) &&
+                 (c < (DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA + (DATALOG_LOGGINGMODE_NUM - 1))))
+            entrySize = 9;
+        else if ((c == DATALOG_ENTRY_BURST_8BIT) ||
+                 (c == DATALOG_ENTRY_BURST_16BIT))
+        {
+            if ((end - p) < 2)
+                return;
+
+            entrySize = 2 + p[1] * ((c == DATALOG_ENTRY_BURST_16BIT) ? 2 : 1);
+        }
+        else
+            entrySize = 1;
+
+        // Entries never cross page boundaries
+        if ((uint32_t)(end - p) < entrySize)
+            return;
+
+        if (c < DATALOG_ENTRY_INCREMENTAL_5BYTES)
+        {
+            uint32_t value;
+            if (entrySize == 2)
+                value = ((c & 0x3f) << 8) | p[1];
+            else if (entrySize == 3)
+                value = ((c & 0x1f) << 16) | (p[1] << 8) | p[2];
+            else
+                value = ((uint32_t)(c & 0x0f) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+
+            emitIncrementalRecord(decoder, value);
+        }
+        else if (c == DATALOG_ENTRY_INCREMENTAL_5BYTES)
+            emitIncrementalRecord(decoder, decodeFixedUInt32(p + 1));
+        else if (entrySize == 9)
+        {
+            // Time interval, absolute timestamp and pulse count value
+            decoder->deltaOfDelta = (c >= DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA);
+            decoder->delta = 0;
+
+            uint32_t mode = decoder->deltaOfDelta
+                                ? (c - DATALOG_ENTRY_ABSOLUTE_DELTAOFDELTA) + 1
+                                : (c - DATALOG_ENTRY_ABSOLUTE) + 1;
+            decoder->timeInterval = loggingModeIntervals[mode];
+            decoder->time = decodeFixedUInt32(p + 1);
+            decoder->milliseconds = 0;
+            decoder->pulseCount = decodeFixedUInt32(p + 5);
+            emitRecord(decoder);
+        }
+        else if ((c == DATALOG_ENTRY_BURST_8BIT) ||
+                 (c == DATALOG_ENTRY_BURST_16BIT))
+            emitBurstRecords(decoder, p + 2, p[1], (c == DATALOG_ENTRY_BURST_16BIT) ? 2 : 1);
+        else if (c == DATALOG_ENTRY_SESSION_START)
+            decoder->sessionStart = true;
+        else if ((c == DATALOG_ENTRY_EMPTY) && writable)
+            return;
+
+        p += entrySize;
+    }
+}
+
+// Decoder
+
+size_t decodeDatalog(const uint8_t *image,
+                     size_t imageSize,
+                     uint32_t pageSize,
+                     uint32_t wordSize,
+                     uint32_t *time,
+                     uint16_t *milliseconds,
+                     uint32_t *pulseCount,
+                     uint8_t *sessionStart,
+                     size_t maxRecordNum)
+{
+    if (!pageSize || !wordSize || (wordSize >= pageSize) ||
+        ((imageSize / pageSize) == 0))
+        return 0;
+
+    Decoder decoder = {
+        .image = image,
+        .pageSize = pageSize,
+        .pageNum = imageSize / pageSize,
+        .pageStateOffset = pageSize - wordSize,
+        .wordSize = wordSize,
+
+        .timeColumn = time,
+        .millisecondsColumn = milliseconds,
+        .pulseCountColumn = pulseCount,
+        .sessionStartColumn = sessionStart,
+        .maxRecordNum = maxRecordNum,
+    };
+
+    uint32_t headPageIndex;
+    uint32_t tailPageIndex;
+    if (!getDatalogHead(&decoder, &headPageIndex, &tailPageIndex))
+        return 0;
+
+    uint32_t pageIndex = headPageIndex;
+    while (true)
+    {
+        bool writable = (pageIndex == tailPageIndex);
+
+        decodePage(&decoder, pageIndex, writable);
+
+        if (writable)
+            break;
+
+        pageIndex = (pageIndex + 1) % decoder.pageNum;
+    }
+
+    return decoder.recordNum;
+}
@@ -0,0 +1,36 @@
+/*
+ * Rad Pro
+ * Data log decoder
+ *
+ * (C) 2022-2026 Gissio
+ *
+ * License: MIT
+ */
+
+#if !defined(RADPRO_DATALOG_H)
+#define RADPRO_DATALOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Decodes a raw data log flash image (as returned by GET datalogRaw, or the
+// data log region of a simulator radpro-settings.bin) into columnar arrays,
+// ordered from least to most recent record. milliseconds[i] holds the
+// sub-second part of time[i] for burst logging samples, 0 otherwise.
+// sessionStart[i] is set when a new logging session starts at record i.
+//
+// Arrays must hold maxRecordNum entries. Returns the number of records in
+// the image, which may exceed maxRecordNum (a single byte can hold a run of
+// records), or 0 if the image holds no valid data log.
+
+size_t decodeDatalog(const uint8_t *image,
+                     size_t imageSize,
+                     uint32_t pageSize,
+                     uint32_t wordSize,
+                     uint32_t *time,
+                     uint16_t *milliseconds,
+                     uint32_t *pulseCount,
+                     uint8_t *sessionStart,
+                     size_t maxRecordNum);
+
+#endif
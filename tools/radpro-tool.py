@@ -15,6 +15,12 @@ import requests
 import serial
 import sys
 import time
+import zlib
+
+try:
+    import radpro_datalog
+except ImportError:
+    radpro_datalog = None
 
 
 # Definitions
@@ -66,7 +72,7 @@ class RadProIO:
             port=self.port, baudrate=115200, timeout=0.5, write_timeout=0.5
         )
 
-    def query(self, request):
+    def query(self, request, log_errors=True):
         response = None
         response_bytes = None
 
@@ -78,6 +84,10 @@ class RadProIO:
 
             response_bytes = self.serial.readline()
 
+            # Skip records sent by a subscription
+            while response_bytes.startswith(b"DATA "):
+                response_bytes = self.serial.readline()
+
         except (serial.SerialException, OSError) as e:
             log_warning(f"Serial communication error: {e}")
 
@@ -99,16 +109,45 @@ class RadProIO:
         if response.startswith("OK"):
             return response[3:]
         else:
-            log_warning(f'request "{request}": response "{response}"')
+            if log_errors:
+                log_warning(f'request "{request}": response "{response}"')
 
             return None
 
-    def get(self, key):
-        return self.query(f"GET {key}")
+    def get(self, key, log_errors=True):
+        return self.query(f"GET {key}", log_errors)
 
     def set(self, key, value):
         return self.query(f"SET {key} {value}")
 
+    def read_record(self):
+        """Read a record sent by a subscription, or None on timeout."""
+        try:
+            if self.serial is None:
+                self.open()
+
+            response_bytes = self.serial.readline()
+
+        except (serial.SerialException, OSError) as e:
+            log_warning(f"Serial communication error: {e}")
+
+            time.sleep(5)
+
+            self.serial = None
+
+            return None
+
+        try:
+            response = response_bytes.decode("ascii").strip()
+        except UnicodeDecodeError as e:
+            log_warning(f"Failed to decode response: {e}")
+            return None
+
+        if not response.startswith("DATA "):
+            return None
+
+        return response[5:].split(",")
+
 
 # Helper functions
 
@@ -121,12 +160,37 @@ def print_property(io, key):
         print(f"{key}:{value}")
 
 
+def print_properties(io, keys):
+    """Get and print device properties with a single request."""
+    values = None
+    if len(keys) > 1:
+        response = io.get(",".join(keys), log_errors=False)
+
+        if response is not None:
+            values = response.split(",")
+
+    # Older firmware only supports one key per request
+    if values is None or len(values) != len(keys):
+        for key in keys:
+            print_property(io, key)
+
+        return
+
+    for key, value in zip(keys, values):
+        print(f"{key}:{value}")
+
+
 def reset_tube_life_stats(io):
     """Reset tube life statistics to zero."""
     io.set("tubeTime", 0)
     io.set("tubePulseCount", 0)
 
 
+def start_datalog_burst(io, burst_time):
+    """Start sub-second burst logging."""
+    io.set("datalogBurst", burst_time)
+
+
 def sync_time(io):
     """Synchronize device time and timezone with system."""
     current_time = int(time.time())
@@ -154,8 +218,8 @@ def get_sensitivity(io):
     return None
 
 
-def get_datalog(io, start_datetime, end_datetime, max_record_num):
-    """Retrieve data log from device within optional time range."""
+def get_datalog_time_range(start_datetime, end_datetime):
+    """Convert optional ISO 8601 date and time limits to UNIX timestamps."""
     if start_datetime is not None:
         start_time = int(datetime.fromisoformat(start_datetime).timestamp())
     else:
@@ -166,12 +230,141 @@ def get_datalog(io, start_datetime, end_datetime, max_record_num):
     else:
         end_time = 4294967295
 
+    return start_time, end_time
+
+
+def get_datalog(io, start_time, end_time, max_record_num):
+    """Retrieve data log from device within optional time range."""
     if max_record_num is not None:
         return io.get(f"datalog {start_time} {end_time} {max_record_num}")
     else:
         return io.get(f"datalog {start_time} {end_time}")
 
 
+def get_datalog_raw(io):
+    """Retrieve raw data log flash pages from device, resuming on corrupt blocks."""
+    image = None
+    from_page = 0
+    retry_num = 0
+
+    while True:
+        response = io.get(f"datalogRaw {from_page}", log_errors=False)
+        if response is None:
+            return None
+
+        blocks = response.split(";")
+
+        try:
+            page_size, page_num, word_size = [int(value) for value in blocks[0].split(",")]
+        except ValueError:
+            log_warning(f'could not decode raw data log header: "{blocks[0]}"')
+            return None
+
+        if image is None:
+            image = bytearray(page_size * page_num)
+
+        next_offset = from_page * page_size
+
+        for block in blocks[1:]:
+            try:
+                offset, data, crc = block.split(",")
+                offset = int(offset)
+                data = bytes.fromhex(data)
+                crc = int(crc, 16)
+            except ValueError:
+                break
+
+            if offset != next_offset or zlib.crc32(data) != crc:
+                break
+
+            image[offset : offset + len(data)] = data
+            next_offset += len(data)
+
+        if next_offset >= len(image):
+            return bytes(image), page_size, word_size
+
+        retry_num += 1
+        if retry_num > 3:
+            log_warning("could not download raw data log: too many errors")
+            return None
+
+        from_page = next_offset // page_size
+        log_info(f"corrupt raw data log block, resuming from page {from_page}")
+
+
+def parse_datalog(datalog):
+    """Parse a GET datalog response into records (None marks a new session)."""
+    records = []
+
+    for index, record in enumerate(datalog.split(";")):
+        # Ignore header
+        if index == 0:
+            continue
+
+        # New logging session
+        if record == "":
+            records.append(None)
+            continue
+
+        values = record.split(",")
+
+        if len(values) != 2:
+            log_warning(f'invalid record: "{record}"')
+            continue
+
+        try:
+            curr_timestamp = int(values[0])
+        except Exception as e:
+            log_warning(f'could not decode timestamp: record "{record}": {e}')
+            continue
+
+        try:
+            curr_pulsecount = int(values[1])
+        except Exception as e:
+            log_warning(f'could not decode pulse count: record "{record}": {e}')
+            continue
+
+        records.append((curr_timestamp, curr_pulsecount))
+
+    return records
+
+
+def decode_datalog_image(
+    image, page_size, word_size, start_time=0, end_time=4294967295, max_record_num=None
+):
+    """Decode a raw data log image into records (None marks a new session)."""
+    times, milliseconds, pulsecounts, session_starts = radpro_datalog.decode_datalog(
+        image, page_size, word_size
+    )
+
+    if max_record_num is None:
+        max_record_num = len(times)
+    else:
+        max_record_num = int(max_record_num)
+
+    records = []
+    record_num = 0
+
+    for index in range(len(times)):
+        curr_timestamp = times[index]
+        if milliseconds[index]:
+            # Burst logging sample
+            curr_timestamp += milliseconds[index] / 1000
+
+        if (
+            curr_timestamp >= start_time
+            and curr_timestamp <= end_time
+            and record_num < max_record_num
+        ):
+            if session_starts[index]:
+                records.append(None)
+
+            records.append((curr_timestamp, pulsecounts[index]))
+            record_num += 1
+
+    return records
+
+
 def get_pulsecount(io):
     """Get current pulse count from device."""
     response = io.get("tubePulseCount")
@@ -185,6 +378,42 @@ def get_pulsecount(io):
     return None
 
 
+def subscribe_pulsecount(io, period):
+    """Make the device send its pulse count every period seconds."""
+    return io.query(f"SUBSCRIBE tubePulseCount {period * 1000}") is not None
+
+
+def read_subscribed_pulsecount(io, timeout):
+    """Wait for a subscription record, returning (tick, pulse count)."""
+    end_time = time.time() + timeout
+
+    while time.time() < end_time:
+        record = io.read_record()
+
+        if record is not None:
+            try:
+                return int(record[0]), int(record[1])
+            except (ValueError, IndexError):
+                log_warning(f'could not decode record: "{",".join(record)}"')
+
+    return None
+
+
+def get_pulsetimestamps(io):
+    """Get pulse timestamps captured by device since the last request."""
+    response = io.get("pulseTimestamps")
+
+    if response is not None:
+        try:
+            values = response.split(";")
+
+            return int(values[0]), [int(value) for value in values[1:]]
+        except ValueError:
+            log_warning(f'could not decode pulse timestamps: "{response}"')
+
+    return None
+
+
 def get_randomdata(io):
     """Get randomly generated data from device."""
     response = io.get("randomData")
@@ -202,68 +431,87 @@ def download_datalog(io, path, start_datetime, end_datetime, max_record_num):
     """Download and process data log to CSV file."""
     sensitivity = get_sensitivity(io)
 
-    datalog = get_datalog(io, start_datetime, end_datetime, max_record_num)
-    if datalog is None:
-        return
+    start_time, end_time = get_datalog_time_range(start_datetime, end_datetime)
+
+    records = None
+
+    # Fast path: download raw flash pages and decode them natively
+    if radpro_datalog is not None and radpro_datalog.is_available():
+        datalog_raw = get_datalog_raw(io)
+        if datalog_raw is not None:
+            records = decode_datalog_image(
+                *datalog_raw, start_time, end_time, max_record_num
+            )
+
+    if records is None:
+        datalog = get_datalog(io, start_time, end_time, max_record_num)
+        if datalog is None:
+            return
+
+        records = parse_datalog(datalog)
+
+    write_datalog(path, records, sensitivity)
+
+
+def convert_datalog_image(image_path, path, offset, page_size, word_size):
+    """Convert an archived raw data log image to CSV file."""
+    if radpro_datalog is None or not radpro_datalog.is_available():
+        log_error("data log decoder library not found")
 
-    records = datalog.split(";")
+    try:
+        with open(image_path, "rb") as f:
+            image = f.read()[offset:]
+    except IOError as e:
+        log_error(f"could not read {image_path}: {e}")
+
+    records = decode_datalog_image(image, page_size, word_size)
+
+    write_datalog(path, records, None)
+
+
+def write_datalog(path, records, sensitivity):
+    """Write data log records to CSV file."""
     lines = []
 
     prev_timestamp = None
     prev_pulsecount = None
 
-    for index, record in enumerate(records):
-        # Ignore header
-        if index == 0:
-            continue
-
+    for record in records:
         # New logging session
-        if record == "":
+        if record is None:
             prev_timestamp = None
             prev_pulsecount = None
             continue
 
-        values = record.split(",")
-
-        if len(values) != 2:
-            log_warning(f'invalid record: "{record}"')
-            continue
-
-        try:
-            curr_timestamp = int(values[0])
-            curr_datetime = str(datetime.fromtimestamp(curr_timestamp))
-        except Exception as e:
-            log_warning(f'could not decode timestamp: record "{record}": {e}')
-            continue
-
-        try:
-            curr_pulsecount = int(values[1])
-        except Exception as e:
-            log_warning(f'could not decode pulse count: record "{record}": {e}')
-            continue
+        curr_timestamp, curr_pulsecount = record
+        curr_datetime = str(datetime.fromtimestamp(curr_timestamp))
 
         cpm = None
+        uSvH = None
         if prev_timestamp is not None:
             curr_deltatime = curr_timestamp - prev_timestamp
 
             if curr_deltatime < 0:
-                log_warning(f'time moving backwards: record "{record}"')
+                log_warning(f'time moving backwards: record "{curr_timestamp},{curr_pulsecount}"')
             else:
                 delta_pulsecount = curr_pulsecount - prev_pulsecount
                 if delta_pulsecount < 0:
-                    log_warning(f'pulse count moving backwards: record "{record}"')
+                    log_warning(f'pulse count moving backwards: record "{curr_timestamp},{curr_pulsecount}"')
 
                 if curr_deltatime > 0:
                     cpm = delta_pulsecount * 60 / curr_deltatime
-                    uSvH = cpm / sensitivity
+                    if sensitivity is not None:
+                        uSvH = cpm / sensitivity
 
         prev_timestamp = curr_timestamp
         prev_pulsecount = curr_pulsecount
 
-        if cpm is not None:
+        if cpm is not None and uSvH is not None:
             lines.append(
                 f"{curr_timestamp},{curr_datetime},{curr_pulsecount},{cpm:.1f},{uSvH:.3f}\n"
             )
+        elif cpm is not None:
+            lines.append(f"{curr_timestamp},{curr_datetime},{curr_pulsecount},{cpm:.1f},\n")
         else:
             lines.append(f"{curr_timestamp},{curr_datetime},{curr_pulsecount},,\n")
 
@@ -316,16 +564,49 @@ def stream_datalog(io, args):
             except IOError as e:
                 log_error(f'could not create file: "{args.pulsedata_file}": {e}')
 
+    # Pulse counts alone are sent by the device, timed by its own clock
+    subscribed = (
+        log_pulsecounts
+        and args.randomdata_file is None
+        and args.pulseintervals_file is None
+        and subscribe_pulsecount(io, args.period)
+    )
+    tick_origin = None
+
     next_event = int(time.time())
 
-    prev_timestamp = None
+    prev_time = None
     prev_pulsecount = None
+    prev_pulse_timestamp = None
 
     while True:
         # Measurement
         if log_pulsecounts:
-            curr_pulsecount = get_pulsecount(io)
-            curr_timestamp = int(time.time())
+            if subscribed:
+                record = read_subscribed_pulsecount(io, 2 * args.period)
+
+                if record is None:
+                    # Device was reset or reconnected
+                    curr_pulsecount = None
+                    curr_time = time.time()
+                    tick_origin = None
+
+                    subscribe_pulsecount(io, args.period)
+                else:
+                    tick, curr_pulsecount = record
+
+                    if tick_origin is not None:
+                        curr_time = tick_origin[1] + ((tick - tick_origin[0]) & 0xFFFFFFFF) / 1000
+
+                    # Follow the host clock if the device clock drifts
+                    if tick_origin is None or abs(curr_time - time.time()) > 1:
+                        tick_origin = (tick, time.time())
+                        curr_time = tick_origin[1]
+            else:
+                curr_pulsecount = get_pulsecount(io)
+                curr_time = time.time()
+
+            curr_timestamp = int(curr_time)
 
             if curr_pulsecount is None:
                 while next_event < curr_timestamp:
@@ -333,7 +614,7 @@ def stream_datalog(io, args):
 
             cpm = None
             if curr_pulsecount is not None and prev_pulsecount is not None:
-                curr_deltatime = curr_timestamp - prev_timestamp
+                curr_deltatime = curr_time - prev_time
 
                 delta_pulsecount = curr_pulsecount - prev_pulsecount
                 if delta_pulsecount < 0:
@@ -343,7 +624,7 @@ def stream_datalog(io, args):
                     cpm = delta_pulsecount * 60 / curr_deltatime
                     uSvH = cpm / sensitivity
 
-            prev_timestamp = curr_timestamp
+            prev_time = curr_time
             prev_pulsecount = curr_pulsecount
 
             curr_datetime = datetime.fromtimestamp(curr_timestamp)
@@ -428,25 +709,55 @@ def stream_datalog(io, args):
                 )
 
         # Wait for next measurement
+        if subscribed:
+            continue
+
         next_event += args.period
 
-        if not args.randomdata_file:
+        if not args.randomdata_file and not args.pulseintervals_file:
             sleep_time = next_event - time.time()
             if sleep_time > 0:
                 time.sleep(sleep_time)
 
         else:
             while time.time() < next_event:
-                data = get_randomdata(io)
-
-                if data is not None:
-                    try:
-                        with open(args.randomdata_file, "ab") as f:
-                            f.write(data)
-                    except IOError as e:
-                        log_error(
-                            f'could not write file: "{args.randomdata_file}": {e}'
-                        )
+                if args.randomdata_file:
+                    data = get_randomdata(io)
+
+                    if data is not None:
+                        try:
+                            with open(args.randomdata_file, "ab") as f:
+                                f.write(data)
+                        except IOError as e:
+                            log_error(
+                                f'could not write file: "{args.randomdata_file}": {e}'
+                            )
+
+                if args.pulseintervals_file:
+                    response = get_pulsetimestamps(io)
+
+                    if response is not None:
+                        lost_num, pulse_timestamps = response
+
+                        # Intervals across lost pulses are not valid
+                        if lost_num > 0:
+                            prev_pulse_timestamp = None
+
+                        data = bytearray()
+                        for pulse_timestamp in pulse_timestamps:
+                            if prev_pulse_timestamp is not None:
+                                interval = (pulse_timestamp - prev_pulse_timestamp) & 0xFFFFFFFF
+                                data += interval.to_bytes(4, "big")
+
+                            prev_pulse_timestamp = pulse_timestamp
+
+                        try:
+                            with open(args.pulseintervals_file, "ab") as f:
+                                f.write(data)
+                        except IOError as e:
+                            log_error(
+                                f'could not write file: "{args.pulseintervals_file}": {e}'
+                            )
 
                 time.sleep(0.05)
 
@@ -492,6 +803,37 @@ def main():
         dest="datalog_max_record_num",
         help="limit the number of data log records to download",
     )
+    parser.add_argument(
+        "--start-datalog-burst",
+        dest="datalog_burst_time",
+        type=int,
+        help="log pulse counts every 100 ms for a number of seconds (1 to 600)",
+    )
+
+    parser.add_argument(
+        "--convert-datalog-image",
+        nargs=2,
+        metavar=("IMAGE_FILE", "CSV_FILE"),
+        help="convert a raw data log image (e.g. an archived GET datalogRaw download or the simulator's radpro-settings.bin) to a .csv file",
+    )
+    parser.add_argument(
+        "--datalog-image-offset",
+        type=lambda value: int(value, 0),
+        default=0,
+        help="data log offset within the image file (default: 0)",
+    )
+    parser.add_argument(
+        "--datalog-image-page-size",
+        type=lambda value: int(value, 0),
+        default=1024,
+        help="flash page size of the image file (default: 1024)",
+    )
+    parser.add_argument(
+        "--datalog-image-word-size",
+        type=lambda value: int(value, 0),
+        default=2,
+        help="flash word size of the image file (default: 2)",
+    )
 
     parser.add_argument(
         "--log-pulsedata",
@@ -565,6 +907,12 @@ def main():
         help="log live randomly generated data to a binary file",
     )
 
+    parser.add_argument(
+        "--log-pulseintervals",
+        dest="pulseintervals_file",
+        help="log live pulse intervals (in microseconds, 32-bit big-endian) to a binary file",
+    )
+
     parser.add_argument("--get-device-id", action="store_true", help="get device id")
     parser.add_argument(
         "--get-device-battery-voltage",
@@ -627,6 +975,19 @@ def main():
         print("radpro-tool " + radpro_tool_version)
         sys.exit(0)
 
+    if args.convert_datalog_image:
+        print("Converting data log image...")
+
+        convert_datalog_image(
+            args.convert_datalog_image[0],
+            args.convert_datalog_image[1],
+            args.datalog_image_offset,
+            args.datalog_image_page_size,
+            args.datalog_image_word_size,
+        )
+
+        sys.exit(2 if log_warnings else 0)
+
     if not args.port:
         parser.print_usage()
         log_error("the following arguments are required: -p/--port")
@@ -645,59 +1006,37 @@ def main():
     if args.get_device_id:
         print_property(io, "deviceId")
 
-    if args.get_device_battery_voltage:
-        print_property(io, "deviceBatteryVoltage")
+    property_keys = [
+        key
+        for key, requested in (
+            ("deviceBatteryVoltage", args.get_device_battery_voltage),
+            ("tubeTime", args.get_tube_time),
+            ("tubePulseCount", args.get_tube_pulse_count),
+            ("tubeType", args.get_tube_type),
+            ("tubeRate", args.get_tube_rate),
+            ("tubeSensitivity", args.get_tube_sensitivity),
+            ("tubeDeadTime", args.get_tube_dead_time),
+            ("tubeDeadTimeCompensation", args.get_tube_dead_time_compensation),
+            ("tubeHVDutyCycle", args.get_tube_hv_duty_cycle),
+            ("tubeHVFrequency", args.get_tube_hv_frequency),
+        )
+        if requested
+    ]
+
+    if property_keys:
+        print_properties(io, property_keys)
 
     if not args.no_sync_time:
-        if (
-            not args.get_device_id
-            and not args.get_device_battery_voltage
-            and not args.get_tube_type
-            and not args.get_tube_time
-            and not args.get_tube_pulse_count
-            and not args.get_tube_rate
-            and not args.get_tube_sensitivity
-            and not args.get_tube_dead_time
-            and not args.get_tube_dead_time_compensation
-            and not args.get_tube_hv_duty_cycle
-            and not args.get_tube_hv_frequency
-        ):
+        if not args.get_device_id and not property_keys:
             print("Syncing time...")
 
         sync_time(io)
 
-    if args.get_tube_time:
-        print_property(io, "tubeTime")
-
-    if args.get_tube_pulse_count:
-        print_property(io, "tubePulseCount")
-
     if args.reset_tube_life_stats:
         print("Resetting tube life stats...")
 
         reset_tube_life_stats(io)
 
-    if args.get_tube_type:
-        print_property(io, "tubeType")
-
-    if args.get_tube_rate:
-        print_property(io, "tubeRate")
-
-    if args.get_tube_sensitivity:
-        print_property(io, "tubeSensitivity")
-
-    if args.get_tube_dead_time:
-        print_property(io, "tubeDeadTime")
-
-    if args.get_tube_dead_time_compensation:
-        print_property(io, "tubeDeadTimeCompensation")
-
-    if args.get_tube_hv_duty_cycle:
-        print_property(io, "tubeHVDutyCycle")
-
-    if args.get_tube_hv_frequency:
-        print_property(io, "tubeHVFrequency")
-
     if args.datalog_file:
         print("Downloading data log...")
 
@@ -709,9 +1048,15 @@ def main():
             args.datalog_max_record_num,
         )
 
+    if args.datalog_burst_time is not None:
+        print("Starting burst logging...")
+
+        start_datalog_burst(io, args.datalog_burst_time)
+
     if (
         args.pulsedata_file is not None
         or args.randomdata_file is not None
+        or args.pulseintervals_file is not None
         or args.submit_gmcmap is not None
         or args.submit_radmon is not None
         or args.submit_safecast is not None
@@ -22,7 +22,7 @@
 #define TTY_BAUDRATE B115200
 
 #define CHECK_TIME 60
-#define CLOCK_SET_TIME 3600
+#define CLOCK_TOLERANCE 2
 
 #define LOG_BASEPATH "/www/www/radpro/"
 
@@ -98,23 +98,33 @@ bool readSerialPortLine(int serialPort, char *buffer, int bufferSize)
 {
     int index = 0;
 
-    for (int i = 0; i < 10; i++)
+    // Read byte-wise, as subscription records may follow a response
+    for (int i = 0; i < 10;)
     {
-        size_t n = read(serialPort,
-                        buffer + index,
-                        bufferSize - index - 1);
+        char c;
+        ssize_t n = read(serialPort, &c, 1);
         if (n < 0)
             break;
+        else if (n == 0)
+        {
+            i++;
 
-        index += n;
+            continue;
+        }
 
-        if ((index > 0) &&
-            (buffer[index - 1] == '\n'))
+        if (c == '\n')
         {
-            buffer[index - 1] = '\0';
+            if ((index > 0) &&
+                (buffer[index - 1] == '\r'))
+                index--;
+
+            buffer[index] = '\0';
 
             return true;
         }
+
+        if (index < (bufferSize - 1))
+            buffer[index++] = c;
     }
 
     buffer[0] = '\0';
@@ -133,12 +143,15 @@ bool sendRequest(int serialPort,
         return false;
     }
 
-    if (!readSerialPortLine(serialPort, buffer, bufferSize))
+    do
     {
-        logError("Could not receive response.\n");
+        if (!readSerialPortLine(serialPort, buffer, bufferSize))
+        {
+            logError("Could not receive response.\n");
 
-        return false;
-    }
+            return false;
+        }
+    } while (strncmp(buffer, "DATA ", 5) == 0);
 
     if (strncmp(buffer, "OK", 2) != 0)
     {
@@ -189,73 +202,104 @@ void appendLogRecord(time_t recordTime,
 
 int main(int argc, char *argv[])
 {
-    time_t lastCheckTime = 0;
-    time_t lastLogTime = 0;
-    time_t lastDeviceTime = 0;
+    int serialPort = -1;
+
+    time_t lastRecordTime = 0;
 
+    bool lastPulseCountValid = false;
     uint32_t lastPulseCount = 0;
 
     while (true)
     {
-        time_t currentTime = time(NULL);
-        time_t deltaTime = currentTime - lastCheckTime;
+        char buffer[256];
 
-        if (deltaTime >= CHECK_TIME)
+        // The device sends its pulse count and clock every CHECK_TIME seconds
+        if (serialPort < 0)
         {
-            int serialPort;
-
             if (!openSerialPort(TTY_DEVICE, &serialPort))
                 logError("Could not open %s.\n", TTY_DEVICE);
+            else if (!configureSerialPort(serialPort))
+                logError("Could not configure %s.\n", TTY_DEVICE);
             else
             {
-                if (!configureSerialPort(serialPort))
-                    logError("Could not configure %s.\n", TTY_DEVICE);
-                else
+                sprintf(buffer,
+                        "SUBSCRIBE tubePulseCount,deviceTime %u",
+                        CHECK_TIME * 1000);
+
+                if (sendRequest(serialPort,
+                                buffer,
+                                sizeof(buffer)))
                 {
-                    char buffer[256];
+                    lastRecordTime = time(NULL);
+                    lastPulseCountValid = false;
 
-                    strcpy(buffer, "GET tubePulseCount");
+                    continue;
+                }
+            }
 
-                    if (sendRequest(serialPort,
-                                    buffer,
-                                    sizeof(buffer)))
-                    {
-                        uint32_t pulseCount = strtoul(buffer, NULL, 10);
+            if (serialPort >= 0)
+                closeSerialPort(serialPort);
 
-                        if ((lastLogTime > 0) && (deltaTime < (2 * CHECK_TIME)))
-                        {
-                            uint32_t deltaPulseCount = pulseCount - lastPulseCount;
+            serialPort = -1;
 
-                            appendLogRecord(currentTime, deltaPulseCount);
-                        }
+            sleep(CHECK_TIME);
 
-                        lastLogTime = currentTime;
-                        lastPulseCount = pulseCount;
-                    }
+            continue;
+        }
 
-                    if ((currentTime - lastCheckTime) < (2 * CHECK_TIME))
-                        lastCheckTime += CHECK_TIME;
-                    else
-                        lastCheckTime = currentTime;
+        bool received = readSerialPortLine(serialPort,
+                                           buffer,
+                                           sizeof(buffer));
+        time_t currentTime = time(NULL);
 
-                    if ((currentTime - lastDeviceTime) >= CLOCK_SET_TIME)
-                    {
-                        sprintf(buffer,
-                                "SET deviceTime %u",
-                                (uint32_t)currentTime);
+        char *pulseCountValue = NULL;
+        if (received &&
+            (strncmp(buffer, "DATA ", 5) == 0))
+            pulseCountValue = strchr(buffer + 5, ',');
 
-                        sendRequest(serialPort,
-                                    buffer,
-                                    sizeof(buffer));
+        if (pulseCountValue)
+        {
+            char *deviceTimeValue;
+            uint32_t pulseCount = strtoul(pulseCountValue + 1, &deviceTimeValue, 10);
 
-                        lastDeviceTime = currentTime;
-                    }
-                }
+            if (lastPulseCountValid)
+            {
+                uint32_t deltaPulseCount = pulseCount - lastPulseCount;
 
-                closeSerialPort(serialPort);
+                appendLogRecord(currentTime, deltaPulseCount);
+            }
+
+            lastRecordTime = currentTime;
+            lastPulseCountValid = true;
+            lastPulseCount = pulseCount;
+
+            // Set the device clock only when it drifts
+            if (*deviceTimeValue == ',')
+            {
+                time_t deviceTime = strtoul(deviceTimeValue + 1, NULL, 10);
+
+                if ((deviceTime < (currentTime - CLOCK_TOLERANCE)) ||
+                    (deviceTime > (currentTime + CLOCK_TOLERANCE)))
+                {
+                    // The response is skipped like any other non-record line
+                    sprintf(buffer,
+                            "SET deviceTime %u",
+                            (uint32_t)currentTime);
+
+                    writeSerialPortLine(serialPort, buffer);
+                }
             }
         }
+        else if ((currentTime - lastRecordTime) >= (2 * CHECK_TIME))
+        {
+            // Device was reset or disconnected
+            logError("Could not receive records.\n");
+
+            closeSerialPort(serialPort);
 
-        usleep(100000);
+            serialPort = -1;
+
+            continue;
+        }
     }
 }
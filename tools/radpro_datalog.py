@@ -0,0 +1,114 @@
+# Rad Pro
+# Data log decoder bindings
+#
+# (C) 2022-2026 Gissio
+#
+# License: MIT
+#
+
+import ctypes
+import os
+import sys
+
+
+# Library loading
+
+_library_names = {
+    "win32": ["radpro-datalog.dll"],
+    "darwin": ["libradpro-datalog.dylib"],
+}.get(sys.platform, ["libradpro-datalog.so"])
+
+_library_dirs = [
+    os.path.dirname(os.path.abspath(__file__)),
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "build"),
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "build", "Release"),
+    os.getcwd(),
+]
+
+
+def _load_library():
+    paths = []
+
+    if "RADPRO_DATALOG_LIBRARY" in os.environ:
+        paths.append(os.environ["RADPRO_DATALOG_LIBRARY"])
+
+    for library_dir in _library_dirs:
+        for library_name in _library_names:
+            paths.append(os.path.join(library_dir, library_name))
+
+    for path in paths:
+        if not os.path.isfile(path):
+            continue
+
+        try:
+            library = ctypes.CDLL(path)
+        except OSError:
+            continue
+
+        library.decodeDatalog.restype = ctypes.c_size_t
+        library.decodeDatalog.argtypes = [
+            ctypes.c_char_p,
+            ctypes.c_size_t,
+            ctypes.c_uint32,
+            ctypes.c_uint32,
+            ctypes.POINTER(ctypes.c_uint32),
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.POINTER(ctypes.c_uint32),
+            ctypes.POINTER(ctypes.c_uint8),
+            ctypes.c_size_t,
+        ]
+
+        return library
+
+    return None
+
+
+_library = _load_library()
+
+
+def is_available():
+    """Return whether the native data log decoder library was found."""
+    return _library is not None
+
+
+def decode_datalog(image, page_size, word_size):
+    """Decode a raw data log flash image into columns.
+
+    Returns a (time, milliseconds, pulse_count, session_start) tuple of
+    memoryviews, ordered from least to most recent record. milliseconds is
+    non-zero only for burst logging samples."""
+    image = bytes(image)
+
+    # Most records take at least one byte; runs of repeated deltas pack
+    # several records into one byte, in which case we decode again
+    max_record_num = len(image)
+
+    while True:
+        time = (ctypes.c_uint32 * max_record_num)()
+        milliseconds = (ctypes.c_uint16 * max_record_num)()
+        pulse_count = (ctypes.c_uint32 * max_record_num)()
+        session_start = (ctypes.c_uint8 * max_record_num)()
+
+        record_num = _library.decodeDatalog(
+            image,
+            len(image),
+            page_size,
+            word_size,
+            time,
+            milliseconds,
+            pulse_count,
+            session_start,
+            max_record_num,
+        )
+
+        if record_num <= max_record_num:
+            break
+
+        max_record_num = record_num
+
+    return (
+        memoryview(time).cast("B").cast("I")[:record_num],
+        memoryview(milliseconds).cast("B").cast("H")[:record_num],
+        memoryview(pulse_count).cast("B").cast("I")[:record_num],
+        memoryview(session_start).cast("B")[:record_num],
+    )